@@ -4,6 +4,9 @@
 #include <cstdint>
 #include <cstring>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -12,38 +15,399 @@
 
 namespace lite {
 
-class LiteBCH {
+class LiteBCH;
+
+// Engine behind the std::vector<B> API. Off runs the byte engine; BitSerial
+// runs the original aff3ct bit-serial encoder and decoder, for verification
+// against aff3ct. Both give the same codewords, and the same messages for
+// every correctable word.
+enum class ReferenceMode { Off, BitSerial };
+
+// When a LiteBCHCode builds its lookup tables. Eager builds all of them in
+// the constructor. Lazy builds only the field tables and the generator
+// there, and the encoder, batch encoder and decoder tables on the first
+// call that needs them (thread-safe), so an encode-only code never holds
+// the decoder tables. Results do not depend on the mode.
+enum class TableMode { Eager, Lazy };
+
+// Allocator for 64-byte (cache line) aligned storage, used for the lookup
+// tables so that rows and SIMD loads do not straddle cache lines.
+template <class T, size_t Align = 64> struct AlignedAllocator {
+  typedef T value_type;
+  template <class U> struct rebind {
+    typedef AlignedAllocator<U, Align> other;
+  };
+
+  AlignedAllocator() = default;
+  template <class U> AlignedAllocator(const AlignedAllocator<U, Align> &) {}
+
+  T *allocate(size_t n) {
+    // Over-allocate and keep the original pointer just below the block.
+    void *raw = ::operator new(n * sizeof(T) + Align + sizeof(void *));
+    uintptr_t p = (reinterpret_cast<uintptr_t>(raw) + sizeof(void *) +
+                   Align - 1) & ~(uintptr_t)(Align - 1);
+    reinterpret_cast<void **>(p)[-1] = raw;
+    return reinterpret_cast<T *>(p);
+  }
+  void deallocate(T *p, size_t) {
+    ::operator delete(reinterpret_cast<void **>(p)[-1]);
+  }
+};
+
+template <class T, class U, size_t A>
+bool operator==(const AlignedAllocator<T, A> &, const AlignedAllocator<U, A> &) {
+  return true;
+}
+template <class T, class U, size_t A>
+bool operator!=(const AlignedAllocator<T, A> &, const AlignedAllocator<U, A> &) {
+  return false;
+}
+
+template <class T> using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Immutable BCH code: Galois field, generator polynomial and lookup tables.
+// All methods are const and keep their per-call state in a Workspace, so one
+// instance can be shared by any number of threads (e.g. through
+// std::shared_ptr<const LiteBCHCode>) as long as each thread uses its own
+// Workspace.
+class LiteBCHCode {
 public:
   using I = int; // Integer type for GF arithmetic
   using B = int; // Bit type (0 or 1)
 
   // Constructor:
-  // N: Codeword length (must be 2^m - 1)
+  // N: Codeword length (must be 2^m - 1, m <= 24; see "wide fields" below)
   // t: Correction capability (number of errors)
   // p: (Optional) Primitive polynomial coefficients. If empty, uses default.
-  LiteBCH(int N, int t, std::vector<I> p = {});
+  // tables: when the lookup tables are built (see TableMode)
+  LiteBCHCode(int N, int t, std::vector<I> p = {},
+              TableMode tables = TableMode::Eager);
+
+  // Process-wide cache of immutable codes keyed by (N, t, p): the first call
+  // builds the code, later calls return the same instance. An empty p means
+  // the default polynomial. Thread-safe.
+  static std::shared_ptr<const LiteBCHCode> get(int N, int t,
+                                                std::vector<I> p = {});
+  // Makes get() return 'code' for its (N, t, p), e.g. after deserialize().
+  static void preload(std::shared_ptr<const LiteBCHCode> code);
+  // Drops the cache's references; codes still in use stay alive.
+  static void clear_cache();
+
+  // Table serialization. serialize() returns a self-contained blob of every
+  // table; deserialize() rebuilds an identical code from it without any
+  // table computation (the blob may live in a memory-mapped file). Blobs are
+  // specific to the byte order of the machine that wrote them.
+  // deserialize() throws std::invalid_argument on a malformed blob.
+  std::vector<uint8_t> serialize() const;
+  static std::shared_ptr<const LiteBCHCode> deserialize(const uint8_t *blob,
+                                                        size_t size);
+
+  // Default primitive polynomial of GF(2^m), coefficients low degree first.
+  static std::vector<I> default_polynomial(int m);
+
+  // Decoder statistics of one Workspace, kept by builds with LITEBCH_STATS
+  // (CMake LITEBCH_ENABLE_STATS; see stats_enabled()). Otherwise the
+  // counters stay zero and the decoder carries no instrumentation at all.
+  // Each Workspace counts on its own (one per thread), so the hot path
+  // needs no atomics; merge() sums the workspaces of several threads.
+  // Stage times are in ticks of the cycle counter: the TSC on x86, the
+  // virtual counter on AArch64, nanoseconds elsewhere.
+  struct DecodeStats {
+    enum Stage { Syndromes, Locator, Roots, Correction, n_stages };
+    uint64_t decoded = 0;   // Words through decode / decode_batch / the bit API
+    uint64_t clean = 0;     // ... that had no errors
+    uint64_t corrected = 0; // ... with errors, all corrected
+    uint64_t failed = 0;    // ... uncorrectable (-1)
+    std::vector<uint64_t> errors; // [t + 1]: words with k errors (k = 0 clean)
+    uint64_t cycles[n_stages] = {};
+
+    void merge(const DecodeStats &o);
+  };
+
+  // Per-word trace event, passed to a Workspace's trace hook after each
+  // counted word. The two-stage API reports each stage's own ticks.
+  struct TraceEvent {
+    size_t len;    // Message bytes
+    int result;    // decode()'s return value
+    const uint64_t *cycles; // [DecodeStats::n_stages] ticks of this word
+  };
+  using TraceHook = void (*)(void *user, const TraceEvent &event);
+
+  // True if the library was built with LITEBCH_STATS
+  static bool stats_enabled();
+
+  // Scratch buffers for one byte-oriented encode/decode call.
+  // Buffers are sized on first use (or up front via the constructor) and
+  // reused afterwards, so steady-state calls do not allocate.
+  // A Workspace must not be used by two calls at the same time.
+  class Workspace {
+  public:
+    Workspace() = default;
+    explicit Workspace(const LiteBCHCode &code) { prepare(code); }
+    explicit Workspace(const LiteBCH &bch);
+
+    size_t memory_usage() const; // Bytes held by the buffers
+
+    // Statistics of the decodes run on this Workspace (see DecodeStats)
+    const DecodeStats &stats() const { return stat; }
+    void reset_stats();
+    // Called on the decoding thread after every counted word (null: none);
+    // only with LITEBCH_STATS.
+    void set_trace_hook(TraceHook hook, void *user) {
+      trace = hook;
+      trace_user = user;
+    }
+
+  private:
+    friend class LiteBCHCode;
+    friend struct DecoderStages;
+    void prepare(const LiteBCHCode &code);
+
+    // Instrumentation (LITEBCH_STATS, src/LiteBCH.cpp)
+    void stat_begin();
+    void stat_lap(DecodeStats::Stage stage);
+    void stat_end(int result, size_t len);
+    DecodeStats stat;
+    uint64_t word_cycles[DecodeStats::n_stages] = {};
+    uint64_t lap_start = 0;
+    TraceHook trace = nullptr;
+    void *trace_user = nullptr;
+
+    int t = -1;
+    int ecc_words = -1;
+    int ecc_bytes = -1;
+    int lanes = -1; // of the SIMD kernels the lane buffers were sized for
+    int k = -1;     // K of the code, for the bit API buffer
+
+    std::vector<uint32_t> par;     // Encoder remainder [ecc_words]
+    std::vector<uint8_t> calc_ecc; // Re-encoded ECC [ecc_bytes]
+    std::vector<uint64_t> wide;    // Carry-less encoder remainder
+    std::vector<uint8_t> bits;     // Bit API data [(K + 7) / 8] + ecc
+
+    // Lockstep batch encoder remainders, byte planes [4 * ecc_words][lanes]
+    std::vector<uint8_t> enc_planes;
+
+    // Decoding buffers
+    // * polynomial form for wide fields (m > 16)
+    std::vector<int> s;       // Syndromes (index form*) [2t + 1]
+    std::vector<int> lambda;  // Error locator (index form*) [t + 1]
+    std::vector<int> bm_b;    // Berlekamp-Massey saved locator [t + 1]
+    std::vector<int> bm_prev; // Berlekamp-Massey scratch [t + 1]
+    std::vector<int> loc;
+    std::vector<int> reg;
 
-  // Fast Byte-Oriented Encoding (Re-introducing for verification)
-  // Input: data bytes (size K/8)
+    // SIMD Chien state, byte planes [t][lanes]
+    std::vector<uint8_t> chien_lo;
+    std::vector<uint8_t> chien_hi;
+
+    // Chase decoding, sized on first use
+    std::vector<int> chase_syn;      // Test bit columns, running [p + 1][t]
+    std::vector<int> chase_best;     // Locator roots of the best candidate [t]
+    std::vector<uint8_t> chase_hard; // Hard decisions of the bit API [N]
+    std::vector<int> side; // Sorted erasure / hint positions [n]
+  };
+
+  // Fast Byte-Oriented Encoding
+  // Input: data bytes, MSB-first. len = (K + 7) / 8 is a full-length
+  //        codeword (the low 8 * len - K bits of the last byte are ignored);
+  //        a smaller len is a shortened codeword of 8 * len message bits,
+  //        and the cost scales with len. Throws if len > (K + 7) / 8.
   // Output: ecc bytes (size ecc_bytes)
-  void encode(const uint8_t *data, size_t len, uint8_t *ecc_out);
+  void encode(const uint8_t *data, size_t len, uint8_t *ecc_out,
+              Workspace &ws) const;
+
+  // Bit-Vector Encoding (aff3ct layout, see encode_bits)
+  // Input: message bits (size K). Output: codeword [parity | message] (N).
+  std::vector<B> encode(const std::vector<B> &message_bits,
+                        ReferenceMode mode = ReferenceMode::Off) const;
+  std::vector<B> encode(const std::vector<B> &message_bits, Workspace &ws,
+                        ReferenceMode mode = ReferenceMode::Off) const;
+
+  // Resumable encoder state: the LFSR remainder of the message bytes fed so
+  // far. Owned by the caller; one state per message in flight.
+  class EncodeState {
+  public:
+    EncodeState() = default;
+    size_t size() const { return bytes; } // message bytes fed so far
+
+  private:
+    friend class LiteBCHCode;
+    const LiteBCHCode *code = nullptr;
+    std::vector<uint32_t> rem; // MSB-aligned remainder [ecc_words]
+    std::vector<uint64_t> wide; // Carry-less encoder scratch
+    size_t bytes = 0;
+  };
+
+  // Streaming Encoding: the message is fed in fragments of any size, and
+  // encode_final() gives the same ECC as encode() over their concatenation
+  // (len = the total size, so the same shortened-code rules apply).
+  // encode_update() throws once the total would exceed (K + 7) / 8 bytes.
+  // encode_begin(st) restarts an existing state without reallocating.
+  EncodeState encode_begin() const;
+  void encode_begin(EncodeState &st) const;
+  void encode_update(EncodeState &st, const uint8_t *data, size_t n) const;
+  void encode_final(const EncodeState &st, uint8_t *ecc_out) const;
+
+  // Scatter-gather encoding over 'count' fragments with iov_base / iov_len
+  // members, e.g. POSIX struct iovec. Same result as encode() over the
+  // concatenated fragments, without copying them.
+  template <class IoVec>
+  void encodev(const IoVec *iov, size_t count, uint8_t *ecc_out,
+               EncodeState &st) const {
+    encode_begin(st);
+    for (size_t i = 0; i < count; ++i)
+      encode_update(st, static_cast<const uint8_t *>(iov[i].iov_base),
+                    iov[i].iov_len);
+    encode_final(st, ecc_out);
+  }
 
-  // Legacy / Bit-Oriented Encoding (slower, for aff3ct compatibility)
-  std::vector<B> encode(const std::vector<B> &message_bits);
+  // Parity update for an in-place write: bytes [offset, offset + n) of a
+  // len-byte message change from old_bytes to new_bytes, and ecc (the ECC
+  // of the old message) becomes the ECC of the new one. The code is linear,
+  // so only the delta is encoded and then moved to its position through
+  // x^(8 2^k) mod g tables: the cost is O(n + log len) rather than O(len).
+  // new_bytes may alias the message itself. Throws if len is invalid (see
+  // encode) or offset + n > len.
+  void update_ecc(uint8_t *ecc, size_t len, size_t offset,
+                  const uint8_t *old_bytes, const uint8_t *new_bytes, size_t n,
+                  Workspace &ws) const;
+
+  // Fast Byte-Oriented Decoding
+  // Input: data (len bytes, as passed to encode), ecc (ecc_bytes)
+  // Corrects data in-place.
+  // Returns number of errors corrected, or -1 if uncorrectable.
+  int decode(uint8_t *data, size_t len, uint8_t *ecc, Workspace &ws) const;
 
   // Decoding:
   // Input: received bits (size N, potentially corrupted)
-  // Output: decoded message bits (size K)
+  // Output: decoded message bits (size K; the received ones if uncorrectable)
   // Returns: true if successful/no error, false if uncorrectable error detected
   bool decode(const std::vector<B> &received_bits,
-              std::vector<B> &decoded_message);
+              std::vector<B> &decoded_message, Workspace &ws,
+              ReferenceMode mode = ReferenceMode::Off) const;
+
+  // Bit-per-element codewords in the aff3ct layout, without allocations:
+  // X_N / Y_N = [parity (N - K bits, x^0 first) | message (K bits)], one B
+  // or one byte per bit (0 / nonzero in, 0 / 1 out). The bits are packed
+  // into bytes for the byte engine with SIMD kernels where available.
+  // encode_bits: U_K[K] -> X_N[N]; U_K may be X_N + N - K (in place).
+  // decode_bits: Y_N[N] -> corrected message V_K[K]. Returns the number of
+  //              errors corrected, or -1 with the received message in V_K.
+  void encode_bits(const B *U_K, B *X_N, Workspace &ws) const;
+  void encode_bits(const uint8_t *U_K, uint8_t *X_N, Workspace &ws) const;
+  int decode_bits(const B *Y_N, B *V_K, Workspace &ws) const;
+  int decode_bits(const uint8_t *Y_N, uint8_t *V_K, Workspace &ws) const;
+
+  // Decoding with side information from the reader, e.g. bits the flash
+  // controller reports as bad or weak. Positions are codeword coefficients
+  // x^j as for decode_chase: ECC bit j is bit j % 8 of ecc[j / 8], message
+  // bit d (j = N - K + d) is the MSB-first data bit min(8 len, K) - 1 - d.
+  // Duplicates are ignored; a position outside the codeword throws
+  // std::invalid_argument. Both return the number of bits changed, or -1.
+  //
+  // decode_erasures: the erased bits' values are unknown. Corrects v errors
+  // elsewhere plus the erasures whenever 2v + e <= 2t (decode() needs
+  // v + e <= t), at the cost of a second locator and root search.
+  // decode_hinted: likely error positions. Same result as decode(); the
+  // locator is checked on the hints first and only the roots left over are
+  // searched for, with a lower degree polynomial (none if all were hinted).
+  int decode_erasures(uint8_t *data, size_t len, uint8_t *ecc,
+                      const int *erasures, size_t n_erasures,
+                      Workspace &ws) const;
+  int decode_hinted(uint8_t *data, size_t len, uint8_t *ecc, const int *hints,
+                    size_t n_hints, Workspace &ws) const;
+
+  // Two-stage decoding, for callers scheduling the stages apart (see
+  // DecodePipeline): decode() is decode_detect() and, if that returns true,
+  // decode_correct() on the same buffers. decode_detect re-encodes the data
+  // and, unless the word is clean (false), stores the odd syndromes S_1,
+  // S_3, ..., S_2t-1 in s (2t + 1 entries, polynomial form as syndromes();
+  // even entries are not written). decode_correct runs the error locator
+  // and root search from them and returns as decode(). The stages may use
+  // different Workspaces and threads.
+  bool decode_detect(const uint8_t *data, size_t len, const uint8_t *ecc,
+                     int *s, Workspace &ws) const;
+  int decode_correct(uint8_t *data, size_t len, uint8_t *ecc, const int *s,
+                     Workspace &ws) const;
+
+  // Chase-II soft-decision decoding. data + ecc hold the hard decisions;
+  // llr[j] is the log-likelihood ratio of the coefficient of x^j, i.e. the
+  // aff3ct layout [parity (N - K) | message] over the N - K + min(8 len, K)
+  // bits of the codeword (ECC bit j is bit j % 8 of ecc[j / 8]; message bit
+  // d is the MSB-first data bit min(8 len, K) - 1 - d). Only |llr| is used.
+  // Each of the 2^p test patterns flips a subset of the p least reliable
+  // bits before a hard decode; the result with the smallest sum of |llr|
+  // over the bits it changes is written back. Costs one syndrome pass plus
+  // 2^p locator and root searches. Throws unless 0 <= p <= 16.
+  // Returns the number of bits changed, or -1 if no pattern decodes.
+  static constexpr int max_chase_positions = 16;
+  int decode_chase(uint8_t *data, size_t len, uint8_t *ecc, const float *llr,
+                   int p, Workspace &ws) const;
+
+  // Chase-II on a full-length codeword of N LLRs in the aff3ct layout
+  // (negative = 1); writes the message (K) to V_K, the hard-decision one if
+  // no pattern decodes. Returns as decode_chase.
+  int decode_chase_bits(const float *Y_N, B *V_K, int p, Workspace &ws) const;
+  int decode_chase_bits(const float *Y_N, uint8_t *V_K, int p,
+                        Workspace &ws) const;
+
+  // Error Detection: true if data + ecc is a valid codeword. Re-encodes data
+  // and compares with ecc; neither buffer is modified and the decoder state
+  // in ws is not touched. Same len rules as decode().
+  bool check(const uint8_t *data, size_t len, const uint8_t *ecc,
+             Workspace &ws) const;
+
+  // Syndromes S_1..S_2t of the codeword data + ecc, computed directly from
+  // the bytes without re-encoding (for m > 16 from the re-encoded
+  // remainder). s must hold 2t + 1 entries; s[i] receives
+  // S_i in polynomial form (s[0] is unused).
+  // Returns true if any syndrome is non-zero, i.e. the codeword has errors.
+  bool syndromes(const uint8_t *data, size_t len, const uint8_t *ecc, int *s,
+                 Workspace &ws) const;
+
+  // Batch Encoding: 'count' messages of 'len' bytes each.
+  // Message c is read from data + c * stride, its ECC is written to
+  // ecc + c * ecc_stride. With SIMD enabled, groups of 16 to 64 messages
+  // (one per vector byte lane) are encoded in lockstep.
+  void encode_batch(const uint8_t *data, size_t len, size_t stride,
+                    size_t count, uint8_t *ecc, size_t ecc_stride,
+                    Workspace &ws) const;
+
+  // Batch Decoding: same layout as encode_batch, corrects in-place.
+  // errors[c] (if not null) receives decode()'s result for codeword c.
+  // Returns the number of uncorrectable codewords.
+  size_t decode_batch(uint8_t *data, size_t len, size_t stride, size_t count,
+                      uint8_t *ecc, size_t ecc_stride, int *errors,
+                      Workspace &ws) const;
+
+  // Batch Error Detection: same layout as encode_batch. valid[c] (if not
+  // null) receives check()'s result for codeword c. Returns the number of
+  // invalid codewords, so only those need a decode().
+  size_t check_batch(const uint8_t *data, size_t len, size_t stride,
+                     size_t count, const uint8_t *ecc, size_t ecc_stride,
+                     bool *valid, Workspace &ws) const;
 
   int get_K() const { return K; }
   int get_N() const { return N; }
   int get_t() const { return t; }
   int get_ecc_bytes() const { return ecc_bytes; }
+  const std::vector<I> &get_polynomial() const { return p; }
+
+  // Bytes held by the lookup tables, per stage. Tables not built yet (see
+  // TableMode::Lazy) count as 0. workspace is only set by
+  // LiteBCH::memory_usage(), for its default Workspace.
+  struct MemoryUsage {
+    size_t gf = 0;      // alpha_to, index_of, p, g
+    size_t encoder = 0; // Encoder (all engines) and parity update tables
+    size_t decoder = 0; // Syndrome and Chien tables
+    size_t workspace = 0;
+    size_t total() const { return gf + encoder + decoder + workspace; }
+  };
+  MemoryUsage memory_usage() const;
 
 private:
+  LiteBCHCode() = default; // filled in by deserialize()
+
   int N;
   int K; // N - redundancy
   int t;
@@ -58,51 +422,423 @@ protected:
   int ecc_bits;
   int ecc_words;
 
-  std::vector<I> alpha_to; // Log table
-  std::vector<I> index_of; // Antilog table
-  std::vector<I> p;        // Primitive polynomial
-  std::vector<I> g;        // Generator polynomial
+  // GF(2^m) tables, m <= 16 (empty for wide fields).
+  // alpha_to[k] = alpha^k for k < 2N, so the sum of two logs needs no % N.
+  // index_of[x] = log(x) for x != 0; index_of[0] = 0xFFFF (see gf_log).
+  AlignedVector<uint16_t> alpha_to; // Log table [2N]
+  AlignedVector<uint16_t> index_of; // Antilog table [N + 1]
+  std::vector<I> p;                 // Primitive polynomial
+  std::vector<I> g;                 // Generator polynomial
+
+  // The tables below belong to one stage each and are built by its init_*
+  // function, in the constructor or on first use (TableMode::Lazy); hence
+  // mutable. Once built they never change.
+
+  // Fast Encoding LUT [4][256][ecc_words], slice-by-4 over 32-bit words.
+  // Remainders are stored MSB-aligned (see init_encode_tables).
+  mutable AlignedVector<uint32_t> encode_tab;
 
-  // Fast Encoding LUT [256][ecc_words]
-  std::vector<std::vector<uint32_t>> encode_lut;
+  // Carry-less multiply encoder [3 + clmul_words()]: [0..2] the Barrett
+  // constants, [3 + w] word w of g without its leading term, times x^pad
+  // (see simd::ClmulArgs)
+  mutable AlignedVector<uint64_t> clmul_tab;
 
-  // Fast Decoding: Syndrome LUT [2*t + 1][256]
-  // syndrome_lut[i][b] = value of byte 'b' evaluated at alpha^i
-  std::vector<std::vector<int>> syndrome_lut;
+  // SIMD lockstep encoder tables [4 * ecc_words][32]: nibble tables of
+  // slice 0 of encode_tab, one per remainder byte (see simd::EncodeArgs)
+  mutable AlignedVector<uint8_t> encode_nib_tab;
 
+  // Parity update tables [levels][256][ecc_words]: level L holds b(x) *
+  // x^(8 2^(shift_base + L)) mod g, MSB-aligned (see init_shift_tables)
+  mutable AlignedVector<uint32_t> shift_tab;
+  mutable int shift_base = 0;
+
+  // Fast Decoding: Syndrome LUT [t][256] of the odd syndromes
+  // syndrome_lut[(i / 2) * 256 + b] = value of byte 'b' evaluated at alpha^i
+  mutable AlignedVector<uint16_t> syndrome_lut;
+
+  // alpha_8_pow[i] = (8 * i) mod N, Horner step for syndrome i
+  mutable std::vector<int> alpha_8_pow;
+
+  // SIMD syndrome tables [t][192] (simd::SyndromeTable) of S_1, S_3, ...
+  mutable AlignedVector<uint8_t> syndrome_tab;
+
+  // SIMD Chien step tables [t][8][16]: nibble tables multiplying term j
+  // (1-based) by alpha^(16 * j)
+  mutable AlignedVector<uint8_t> chien_tab;
+
+  // --- Wide fields (17 <= m <= 24, src/WideField.cpp) ---
+  // Full log tables would no longer fit in cache, so there are none: a
+  // product is a carry-less multiply reduced byte-wise through wide_reduce,
+  // and the decoder's products with fixed elements use byte-split tables
+  // ([3][256], see wide_const_table). Syndromes and locators stay in
+  // polynomial form, and the SIMD decoder kernels are not used.
+  bool wide() const { return m > 16; }
+  uint32_t gf_poly = 0;                // p as bits, x^m included
+  AlignedVector<uint32_t> wide_reduce; // [256]: b(x) * x^m mod p
+
+  // Decoder stage tables
+  mutable AlignedVector<uint32_t> wide_syn_lut;  // [t][256]: byte at alpha^i
+  mutable AlignedVector<uint32_t> wide_syn_step; // [t][3][256]: * alpha^(8i)
+  mutable AlignedVector<uint32_t> wide_chien;    // [t][3][256]: * alpha^j
+  mutable AlignedVector<uint32_t> wide_giant;    // [3][256]: * alpha^-M
+  mutable std::vector<uint64_t> wide_baby; // Sorted alpha^j << 32 | j, j < M
+
+  // Built flag of one stage's tables; copies keep the flag.
+  struct Stage {
+    Stage() = default;
+    Stage(const Stage &o) : ready(o.ready.load()) {}
+    Stage &operator=(const Stage &o) {
+      ready.store(o.ready.load());
+      return *this;
+    }
+    std::atomic<bool> ready{false};
+    std::mutex lock;
+  };
+  mutable Stage encoder_stage; // encode_tab, clmul_tab
+  mutable Stage lanes_stage;   // encode_nib_tab
+  mutable Stage shift_stage;   // shift_tab
+  mutable Stage decoder_stage; // syndrome_lut, alpha_8_pow, syndrome_tab,
+                               // chien_tab
+
+private:
+  // Gives benchmarks (tests/litebch_bench.cpp) access to the decoder stages.
+  friend struct DecoderStages;
+
+  // Initialization helpers (from Galois & BCH_polynomial_generator)
+  void init_galois();
+  void compute_generator_polynomial();
+  void init_encode_tables() const;
+  void init_lane_tables() const;
+  void init_shift_tables() const;
+  void init_decode_tables() const;
+  void init_wide_field();
+  void init_wide_decode_tables() const;
+
+  // Builds a stage's tables unless done; every stage entry point calls its
+  // need_*() first.
+  void build_stage(Stage &stage, void (LiteBCHCode::*init)() const) const;
+  void need_encoder() const {
+    if (!encoder_stage.ready.load(std::memory_order_acquire))
+      build_stage(encoder_stage, &LiteBCHCode::init_encode_tables);
+  }
+  void need_lanes() const {
+    if (!lanes_stage.ready.load(std::memory_order_acquire))
+      build_stage(lanes_stage, &LiteBCHCode::init_lane_tables);
+  }
+  void need_shift() const {
+    if (!shift_stage.ready.load(std::memory_order_acquire))
+      build_stage(shift_stage, &LiteBCHCode::init_shift_tables);
+  }
+  void need_decoder() const {
+    if (!decoder_stage.ready.load(std::memory_order_acquire))
+      build_stage(decoder_stage, &LiteBCHCode::init_decode_tables);
+  }
+
+  // Message bits of a len-byte message, and the len check of the public API
+  int data_bits(size_t len) const {
+    return len * 8 < (size_t)K ? (int)(len * 8) : K;
+  }
+  void check_len(size_t len) const;
+
+  // Core logic (Workspace already prepared)
+  void encode_core(const uint8_t *data, size_t len, uint8_t *ecc_out,
+                   Workspace &ws) const;
+  bool check_core(const uint8_t *data, size_t len, const uint8_t *ecc,
+                  Workspace &ws) const;
+  int clmul_words() const { return (ecc_bits + 63) / 64; }
+  void shift_in_bytes(uint32_t *s, const uint8_t *data, size_t n,
+                      uint64_t *wide) const;
+  void shift_in_bits(uint32_t *s, uint8_t b, int bits) const;
+  void store_ecc(const uint32_t *s, uint8_t *ecc_out) const;
+  void shift_zero_bytes(uint32_t *s, size_t q, uint8_t *digits,
+                        uint64_t *wide) const;
+  void mul_shift(uint32_t *s, const uint32_t *tab, uint8_t *digits) const;
+  void encode_lanes(const uint8_t *data, size_t len, size_t stride,
+                    uint8_t *ecc, size_t ecc_stride, Workspace &ws) const;
+  template <class T> void pack_message(const T *U_K, uint8_t *data) const;
+  template <class T> void unpack_message(uint8_t *data, T *V_K) const;
+  template <class T>
+  void encode_bits_core(const T *U_K, T *X_N, Workspace &ws) const;
+  template <class T>
+  int decode_bits_core(const T *Y_N, T *V_K, Workspace &ws) const;
+  int decode_core(uint8_t *data, size_t len, uint8_t *ecc,
+                  Workspace &ws) const;
+  int correct_core(uint8_t *data, size_t len, uint8_t *ecc, Workspace &ws,
+                   const int *hints = nullptr, size_t n_hints = 0) const;
+  void load_positions(const int *pos, size_t n, size_t len,
+                      Workspace &ws) const;
+  int hinted_roots(const int *elp, int deg, int n_bits, const int *hints,
+                   size_t n_hints, int *loc, Workspace &ws) const;
+  int chase_core(uint8_t *data, size_t len, uint8_t *ecc, const float *llr,
+                 int p, Workspace &ws) const;
+  template <class T>
+  int chase_bits_core(const float *Y_N, T *V_K, int p, Workspace &ws) const;
+
+  // Decoder stages, in order (see decode_core)
+  bool remainder_syndromes(const uint8_t *data, size_t len, const uint8_t *ecc,
+                           Workspace &ws) const;
+  bool remainder_odd_syndromes(const uint8_t *data, size_t len,
+                               const uint8_t *ecc, Workspace &ws) const;
+  bool finish_syndromes(int *s) const;
+  int berlekamp_massey(Workspace &ws) const;
+  int find_roots(const int *elp, int deg, int n_bits, int *loc,
+                 Workspace &ws) const;
+  void correct_errors(uint8_t *data, size_t len, uint8_t *ecc, int count,
+                      const Workspace &ws) const;
+  void flip_bit(uint8_t *data, size_t len, uint8_t *ecc, int bit_idx) const;
+  int get_bit(const uint8_t *data, size_t len, const uint8_t *ecc,
+              int bit_idx) const;
+  void odd_syndromes(const uint8_t *p, size_t n, int *s) const;
+  void even_syndromes(int *s) const;
+  int chien_search(const int *elp, int deg, int n_bits, int *loc,
+                   Workspace &ws) const;
+  int low_degree_roots(const int *elp, int deg, int n_bits, int *loc) const;
+  int solve_affine(int c0, int c1, int c2, int rhs, int *out) const;
+
+  // GF(2^m) arithmetic in polynomial form
+  int gf_log(int a) const; // -1 for 0
+  int gf_mul(int a, int b) const;
+  int gf_div(int a, int b) const;
+  int gf_sqrt(int a) const;
+  int gf_alpha(int64_t e) const; // alpha^e for any e, any field size
+
+  // Wide field arithmetic and decoder stages (see decode_core)
+  uint32_t wide_mul(uint32_t a, uint32_t b) const;
+  uint32_t wide_pow(uint32_t a, uint64_t e) const;
+  void wide_const_table(uint32_t c, uint32_t *tab) const;
+  int wide_log(uint32_t a) const; // -1 for 0
+  void wide_odd_syndromes(const uint8_t *p, size_t n, int *s) const;
+  int wide_berlekamp_massey(Workspace &ws) const;
+  int wide_find_roots(const int *lambda, int deg, int n_bits, int *loc,
+                      Workspace &ws) const;
+
+  // Original aff3ct bit-serial encoder / decoder (ReferenceMode::BitSerial)
+  void __encode(const B *U_K, B *par) const;
+  int _decode(B *Y_N, Workspace &ws) const;
+};
+
+// BCH codec: a (possibly shared) LiteBCHCode plus the scratch buffers used by
+// the overloads without an explicit Workspace. Cheap to create from an
+// existing code, so multi-threaded users keep one LiteBCHCode and one LiteBCH
+// per thread.
+class LiteBCH {
 public:
+  using I = LiteBCHCode::I;
+  using B = LiteBCHCode::B;
+  using Workspace = LiteBCHCode::Workspace;
+  using EncodeState = LiteBCHCode::EncodeState;
+
+  // Builds a private LiteBCHCode(N, t, p, tables).
+  LiteBCH(int N, int t, std::vector<I> p = {},
+          TableMode tables = TableMode::Eager);
+
+  // Shares the tables of an existing code.
+  explicit LiteBCH(std::shared_ptr<const LiteBCHCode> code);
+
+  // Fast Byte-Oriented Encoding (see LiteBCHCode::encode for len)
+  // Input: data bytes (at most (K + 7) / 8)
+  // Output: ecc bytes (size ecc_bytes)
+  void encode(const uint8_t *data, size_t len, uint8_t *ecc_out) {
+    code->encode(data, len, ecc_out, default_ws);
+  }
+  void encode(const uint8_t *data, size_t len, uint8_t *ecc_out,
+              Workspace &ws) const {
+    code->encode(data, len, ecc_out, ws);
+  }
+
+  // Bit-Vector Encoding (see LiteBCHCode::encode), in the reference mode
+  std::vector<B> encode(const std::vector<B> &message_bits) {
+    return code->encode(message_bits, default_ws, mode);
+  }
+
+  // Streaming and scatter-gather encoding (see LiteBCHCode::encode_begin)
+  EncodeState encode_begin() const { return code->encode_begin(); }
+  void encode_begin(EncodeState &st) const { code->encode_begin(st); }
+  void encode_update(EncodeState &st, const uint8_t *data, size_t n) const {
+    code->encode_update(st, data, n);
+  }
+  void encode_final(const EncodeState &st, uint8_t *ecc_out) const {
+    code->encode_final(st, ecc_out);
+  }
+  template <class IoVec>
+  void encodev(const IoVec *iov, size_t count, uint8_t *ecc_out) {
+    code->encodev(iov, count, ecc_out, default_stream);
+  }
+  template <class IoVec>
+  void encodev(const IoVec *iov, size_t count, uint8_t *ecc_out,
+               EncodeState &st) const {
+    code->encodev(iov, count, ecc_out, st);
+  }
+
+  // Parity update for an in-place write (see LiteBCHCode::update_ecc)
+  void update_ecc(uint8_t *ecc, size_t len, size_t offset,
+                  const uint8_t *old_bytes, const uint8_t *new_bytes,
+                  size_t n) {
+    code->update_ecc(ecc, len, offset, old_bytes, new_bytes, n, default_ws);
+  }
+  void update_ecc(uint8_t *ecc, size_t len, size_t offset,
+                  const uint8_t *old_bytes, const uint8_t *new_bytes, size_t n,
+                  Workspace &ws) const {
+    code->update_ecc(ecc, len, offset, old_bytes, new_bytes, n, ws);
+  }
+
+  // Decoding:
+  // Input: received bits (size N, potentially corrupted)
+  // Output: decoded message bits (size K; the received ones if uncorrectable)
+  // Returns: true if successful/no error, false if uncorrectable error detected
+  bool decode(const std::vector<B> &received_bits,
+              std::vector<B> &decoded_message) {
+    return code->decode(received_bits, decoded_message, default_ws, mode);
+  }
+
+  // Engine of the std::vector<B> encode / decode overloads (default Off)
+  void set_reference_mode(ReferenceMode mode) { this->mode = mode; }
+  ReferenceMode get_reference_mode() const { return mode; }
+
+  // Memory held by the code's tables plus the default Workspace. A shared
+  // code is counted in full by every LiteBCH using it.
+  LiteBCHCode::MemoryUsage memory_usage() const {
+    LiteBCHCode::MemoryUsage usage = code->memory_usage();
+    usage.workspace = default_ws.memory_usage();
+    return usage;
+  }
+
+  // Decoder statistics of the default Workspace (see
+  // LiteBCHCode::DecodeStats)
+  const LiteBCHCode::DecodeStats &stats() const { return default_ws.stats(); }
+  void reset_stats() { default_ws.reset_stats(); }
+  void set_trace_hook(LiteBCHCode::TraceHook hook, void *user) {
+    default_ws.set_trace_hook(hook, user);
+  }
+
+  // Bit-per-element codewords (see LiteBCHCode::encode_bits); always on the
+  // byte engine. Bit is B (aff3ct) or uint8_t.
+  template <class Bit> void encode_bits(const Bit *U_K, Bit *X_N) {
+    code->encode_bits(U_K, X_N, default_ws);
+  }
+  template <class Bit>
+  void encode_bits(const Bit *U_K, Bit *X_N, Workspace &ws) const {
+    code->encode_bits(U_K, X_N, ws);
+  }
+  template <class Bit> int decode_bits(const Bit *Y_N, Bit *V_K) {
+    return code->decode_bits(Y_N, V_K, default_ws);
+  }
+  template <class Bit>
+  int decode_bits(const Bit *Y_N, Bit *V_K, Workspace &ws) const {
+    return code->decode_bits(Y_N, V_K, ws);
+  }
+
   // Fast Byte-Oriented Decoding
   // Input: data (len bytes), ecc (ecc_bytes)
   // Corrects data in-place.
   // Returns number of errors corrected, or -1 if uncorrectable.
-  int decode(uint8_t *data, size_t len, uint8_t *ecc);
+  int decode(uint8_t *data, size_t len, uint8_t *ecc) {
+    return code->decode(data, len, ecc, default_ws);
+  }
+  int decode(uint8_t *data, size_t len, uint8_t *ecc, Workspace &ws) const {
+    return code->decode(data, len, ecc, ws);
+  }
 
-private:
-  // Decoding buffers
-  std::vector<std::vector<int>> elp;
-  std::vector<int> discrepancy;
-  std::vector<int> l;
-  std::vector<int> u_lu;
-  std::vector<int> s;
-  std::vector<int> loc;
-  std::vector<int> reg;
+  // Erasure and hint decoding (see LiteBCHCode::decode_erasures)
+  int decode_erasures(uint8_t *data, size_t len, uint8_t *ecc,
+                      const int *erasures, size_t n_erasures) {
+    return code->decode_erasures(data, len, ecc, erasures, n_erasures,
+                                 default_ws);
+  }
+  int decode_erasures(uint8_t *data, size_t len, uint8_t *ecc,
+                      const int *erasures, size_t n_erasures,
+                      Workspace &ws) const {
+    return code->decode_erasures(data, len, ecc, erasures, n_erasures, ws);
+  }
+  int decode_hinted(uint8_t *data, size_t len, uint8_t *ecc, const int *hints,
+                    size_t n_hints) {
+    return code->decode_hinted(data, len, ecc, hints, n_hints, default_ws);
+  }
+  int decode_hinted(uint8_t *data, size_t len, uint8_t *ecc, const int *hints,
+                    size_t n_hints, Workspace &ws) const {
+    return code->decode_hinted(data, len, ecc, hints, n_hints, ws);
+  }
+
+  // Chase-II soft-decision decoding (see LiteBCHCode::decode_chase)
+  int decode_chase(uint8_t *data, size_t len, uint8_t *ecc, const float *llr,
+                   int p) {
+    return code->decode_chase(data, len, ecc, llr, p, default_ws);
+  }
+  int decode_chase(uint8_t *data, size_t len, uint8_t *ecc, const float *llr,
+                   int p, Workspace &ws) const {
+    return code->decode_chase(data, len, ecc, llr, p, ws);
+  }
+  template <class Bit>
+  int decode_chase_bits(const float *Y_N, Bit *V_K, int p) {
+    return code->decode_chase_bits(Y_N, V_K, p, default_ws);
+  }
+  template <class Bit>
+  int decode_chase_bits(const float *Y_N, Bit *V_K, int p,
+                        Workspace &ws) const {
+    return code->decode_chase_bits(Y_N, V_K, p, ws);
+  }
+
+  // Error Detection only: true if data + ecc is a valid codeword
+  bool check(const uint8_t *data, size_t len, const uint8_t *ecc) {
+    return code->check(data, len, ecc, default_ws);
+  }
+  bool check(const uint8_t *data, size_t len, const uint8_t *ecc,
+             Workspace &ws) const {
+    return code->check(data, len, ecc, ws);
+  }
+
+  // Batch API (see LiteBCHCode::encode_batch / decode_batch / check_batch)
+  void encode_batch(const uint8_t *data, size_t len, size_t stride,
+                    size_t count, uint8_t *ecc, size_t ecc_stride) {
+    code->encode_batch(data, len, stride, count, ecc, ecc_stride, default_ws);
+  }
+  size_t decode_batch(uint8_t *data, size_t len, size_t stride, size_t count,
+                      uint8_t *ecc, size_t ecc_stride, int *errors = nullptr) {
+    return code->decode_batch(data, len, stride, count, ecc, ecc_stride, errors,
+                              default_ws);
+  }
+  size_t check_batch(const uint8_t *data, size_t len, size_t stride,
+                     size_t count, const uint8_t *ecc, size_t ecc_stride,
+                     bool *valid = nullptr) {
+    return code->check_batch(data, len, stride, count, ecc, ecc_stride, valid,
+                             default_ws);
+  }
+
+  int get_K() const { return code->get_K(); }
+  int get_N() const { return code->get_N(); }
+  int get_t() const { return code->get_t(); }
+  int get_ecc_bytes() const { return code->get_ecc_bytes(); }
+
+  const std::shared_ptr<const LiteBCHCode> &get_code() const { return code; }
 
 private:
-  // Initialization helpers (from Galois & BCH_polynomial_generator)
-  void init_galois();
-  void select_polynomial();
-  void compute_generator_polynomial();
-  void init_fast_tables();
+  std::shared_ptr<const LiteBCHCode> code;
 
-  // Core logic
-  void __encode(const B *U_K, B *par);
-  int _decode(B *Y_N);
+  // Buffers behind the overloads without an explicit Workspace / state
+  Workspace default_ws;
+  EncodeState default_stream;
+  ReferenceMode mode = ReferenceMode::Off;
 };
 
 // Utility to convert string to bits and back
 std::vector<LiteBCH::B> string_to_bits(const std::string &str);
 std::string bits_to_string(const std::vector<LiteBCH::B> &bits);
 
+// Backend selection. The first coding call binds the best backends the CPU
+// supports: SIMD kernels for syndromes, Chien search and batch encoding
+// ("avx512", "avx2", "ssse3", "neon", "wasm-simd128", "scalar") and the
+// message encoder ("pclmul", "pmull", "table"). The setters override that
+// choice, e.g. to benchmark one backend against another; "auto" restores
+// the automatic choice. They throw std::invalid_argument for a name that is
+// unknown or not usable here, and must not run while other threads code.
+// Results are identical on every backend.
+std::vector<std::string> vector_backends(); // usable ones, best first
+std::string get_vector_backend();
+void set_vector_backend(const std::string &name);
+std::vector<std::string> encode_backends(); // usable ones, best first
+std::string get_encode_backend();
+void set_encode_backend(const std::string &name);
+
 } // namespace lite
 
 #endif // LITE_BCH_H
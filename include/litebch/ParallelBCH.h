@@ -0,0 +1,291 @@
+#ifndef LITE_PARALLEL_BCH_H
+#define LITE_PARALLEL_BCH_H
+
+#include <litebch/LiteBCH.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lite {
+
+// Fixed-size thread pool running one parallel loop at a time.
+// The loop range is cut into chunks; each worker starts with a contiguous
+// share of the chunks and, once its share is drained, steals half of the
+// remaining chunks of another worker. This keeps all workers busy when the
+// cost per item varies (e.g. clean vs. t-error codewords).
+// The calling thread takes part as worker 0.
+class WorkStealingPool {
+public:
+  // threads: total number of workers including the caller (0 = hardware)
+  explicit WorkStealingPool(unsigned threads = 0);
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  unsigned get_threads() const { return n_workers; }
+
+  // Calls fn(begin, end, worker) for consecutive item ranges of at most
+  // 'chunk' items covering [0, count). 'worker' is in [0, get_threads()).
+  // Blocks until every range is done; rethrows the first exception thrown
+  // by fn. Not reentrant: one loop per pool at a time.
+  void parallel_for(size_t count, size_t chunk,
+                    const std::function<void(size_t, size_t, unsigned)> &fn);
+
+private:
+  // Remaining chunk range [lo, hi) of a worker. The owner takes chunks from
+  // the front, thieves take the back half. A chunk is many codewords, so a
+  // per-range lock is cheap next to the work it hands out. Padded so that
+  // neighbouring ranges do not share a cache line.
+  struct Range {
+    std::mutex lock;
+    size_t lo = 0;
+    size_t hi = 0;
+    char pad[64];
+  };
+
+  struct Job {
+    const std::function<void(size_t, size_t, unsigned)> *fn = nullptr;
+    size_t count = 0;
+    size_t chunk = 0;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+  };
+
+  void worker_loop(unsigned worker);
+  void run(Job &job, unsigned worker);
+  bool pop(unsigned worker, size_t &chunk_idx);
+  bool steal(unsigned thief, size_t &chunk_idx);
+
+  unsigned n_workers;
+  std::unique_ptr<Range[]> ranges;
+  std::vector<std::thread> threads;
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  Job *job = nullptr;
+  uint64_t generation = 0;
+  unsigned busy = 0;
+  bool stopping = false;
+};
+
+// Batch codec running encode_batch/decode_batch on a WorkStealingPool with
+// one Workspace per worker over a shared, immutable LiteBCHCode.
+class ParallelBCH {
+public:
+  // threads: number of workers (0 = hardware concurrency)
+  // chunk:   codewords per scheduling unit (0 = derived from the batch size)
+  explicit ParallelBCH(std::shared_ptr<const LiteBCHCode> code,
+                       unsigned threads = 0, size_t chunk = 0);
+
+  // Same layout and results as LiteBCHCode::encode_batch / decode_batch /
+  // check_batch.
+  void encode_batch(const uint8_t *data, size_t len, size_t stride,
+                    size_t count, uint8_t *ecc, size_t ecc_stride);
+  size_t decode_batch(uint8_t *data, size_t len, size_t stride, size_t count,
+                      uint8_t *ecc, size_t ecc_stride, int *errors = nullptr);
+  size_t check_batch(const uint8_t *data, size_t len, size_t stride,
+                     size_t count, const uint8_t *ecc, size_t ecc_stride,
+                     bool *valid = nullptr);
+
+  // Decoder statistics summed over the workers (see
+  // LiteBCHCode::DecodeStats). The trace hook is called on the worker
+  // threads, concurrently. Not while a batch is running.
+  LiteBCHCode::DecodeStats stats() const;
+  void reset_stats();
+  void set_trace_hook(LiteBCHCode::TraceHook hook, void *user);
+
+  void set_chunk_size(size_t chunk) { this->chunk = chunk; }
+  size_t get_chunk_size() const { return chunk; }
+  unsigned get_threads() const { return pool.get_threads(); }
+  const std::shared_ptr<const LiteBCHCode> &get_code() const { return code; }
+
+private:
+  size_t chunk_for(size_t count) const;
+
+  std::shared_ptr<const LiteBCHCode> code;
+  WorkStealingPool pool;
+  size_t chunk;
+  std::vector<LiteBCHCode::Workspace> workspaces; // one per worker
+};
+
+// Bounded multi-producer multi-consumer queue (D. Vyukov's array queue).
+// Each cell carries a sequence number telling producers and consumers
+// whose turn it is, so a push or pop is one compare-and-swap on the shared
+// index and never takes a lock. The capacity is rounded up to a power of
+// two. Items are exchanged with std::swap: a push leaves the cell's old
+// contents in 'item', so buffers inside T circulate instead of being
+// reallocated.
+template <class T> class MPMCQueue {
+public:
+  explicit MPMCQueue(size_t capacity) {
+    size_t n = 2;
+    while (n < capacity)
+      n <<= 1;
+    cells.reset(new Cell[n]);
+    mask = n - 1;
+    for (size_t i = 0; i < n; ++i)
+      cells[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  MPMCQueue(const MPMCQueue &) = delete;
+  MPMCQueue &operator=(const MPMCQueue &) = delete;
+
+  size_t capacity() const { return mask + 1; }
+
+  // False (item untouched) if the queue is full
+  bool try_push(T &item) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &c = cells[pos & mask];
+      size_t seq = c.seq.load(std::memory_order_acquire);
+      std::ptrdiff_t dif = (std::ptrdiff_t)(seq - pos);
+      if (dif == 0) {
+        if (tail.compare_exchange_weak(pos, pos + 1,
+                                       std::memory_order_relaxed)) {
+          std::swap(c.value, item);
+          c.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (dif < 0) {
+        return false; // The cell still holds the item of the last lap
+      } else {
+        pos = tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // False (item untouched) if the queue is empty
+  bool try_pop(T &item) {
+    size_t pos = head.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &c = cells[pos & mask];
+      size_t seq = c.seq.load(std::memory_order_acquire);
+      std::ptrdiff_t dif = (std::ptrdiff_t)(seq - (pos + 1));
+      if (dif == 0) {
+        if (head.compare_exchange_weak(pos, pos + 1,
+                                       std::memory_order_relaxed)) {
+          std::swap(c.value, item);
+          c.seq.store(pos + mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (dif < 0) {
+        return false; // Not written yet
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    T value;
+  };
+  std::unique_ptr<Cell[]> cells;
+  size_t mask;
+  // Producers and consumers each hammer one index; keep them apart.
+  char pad0[64];
+  std::atomic<size_t> head{0}; // Next pop
+  char pad1[64];
+  std::atomic<size_t> tail{0}; // Next push
+  char pad2[64];
+};
+
+// Asynchronous decoder for completion-driven I/O (e.g. io_uring): the I/O
+// thread submits a codeword and returns to its ring at once; worker threads
+// decode it and run the completion. The decoder is split at the syndromes
+// (LiteBCHCode::decode_detect / decode_correct): a first queue feeds the
+// re-encode and syndrome stage, where clean words complete right away, and
+// only words with errors move on to a second queue for the error locator and
+// root search. Workers drain the second queue first, so words already
+// started finish before new ones begin.
+// Both queues are bounded MPMCQueues. try_submit never blocks: when the
+// first queue is full it returns false and the caller keeps the buffer, e.g.
+// to resubmit after reaping more completions (back-pressure).
+class DecodePipeline {
+public:
+  // result: decode()'s return value (errors corrected, or -1)
+  using Callback = std::function<void(int result)>;
+
+  // threads:  worker threads (0 = hardware concurrency); the submitting
+  //           thread never joins in
+  // capacity: words waiting per stage (rounded up to a power of two)
+  explicit DecodePipeline(std::shared_ptr<const LiteBCHCode> code,
+                          unsigned threads = 0, size_t capacity = 1024);
+  ~DecodePipeline(); // Completes every submitted word, then joins
+
+  DecodePipeline(const DecodePipeline &) = delete;
+  DecodePipeline &operator=(const DecodePipeline &) = delete;
+
+  // Queues data + ecc for decoding in place (layout and len as decode()).
+  // 'done' (may be empty) runs on a worker once the word is decoded and
+  // must not throw; both buffers must stay valid and untouched until then.
+  // Returns false, without taking the word, if the queue is full. Throws
+  // std::invalid_argument if len > (K + 7) / 8.
+  bool try_submit(uint8_t *data, size_t len, uint8_t *ecc, Callback done);
+
+  // Future flavour, at the cost of one shared state per word. The future is
+  // not valid() if the queue is full.
+  std::future<int> try_submit(uint8_t *data, size_t len, uint8_t *ecc);
+
+  // Blocks until every word submitted so far has completed. Not from a
+  // completion callback.
+  void drain();
+
+  // Decoder statistics summed over the workers, as ParallelBCH::stats().
+  // Only while no word is in flight (e.g. after drain()), and the hook is
+  // set before the first submit.
+  LiteBCHCode::DecodeStats stats() const;
+  void reset_stats();
+  void set_trace_hook(LiteBCHCode::TraceHook hook, void *user);
+
+  size_t in_flight() const { return pending.load(); } // Submitted, not done
+  size_t get_capacity() const { return detect_q.capacity(); }
+  unsigned get_threads() const { return (unsigned)threads.size(); }
+  const std::shared_ptr<const LiteBCHCode> &get_code() const { return code; }
+
+private:
+  struct Request {
+    uint8_t *data = nullptr;
+    size_t len = 0;
+    uint8_t *ecc = nullptr;
+    Callback done;
+  };
+  // A word with errors and its odd syndromes [2t + 1]
+  struct Located {
+    Request req;
+    std::vector<int> s;
+  };
+
+  void worker_loop(unsigned worker);
+  void wake_worker();                      // After a push
+  void complete(Request &req, int result); // Runs the callback, release()
+  void release();                          // One word less in flight
+
+  std::shared_ptr<const LiteBCHCode> code;
+  MPMCQueue<Request> detect_q;
+  MPMCQueue<Located> correct_q;
+  std::vector<LiteBCHCode::Workspace> workspaces; // one per worker
+  std::vector<std::thread> threads;
+
+  std::atomic<size_t> queued{0};  // Items in either queue (or being pushed)
+  std::atomic<size_t> pending{0}; // Submitted, not completed
+  std::atomic<unsigned> sleeping{0};
+  std::mutex mutex; // Only for sleeping and drain()
+  std::condition_variable wake;
+  std::condition_variable idle;
+  bool stopping = false;
+};
+
+} // namespace lite
+
+#endif // LITE_PARALLEL_BCH_H
@@ -0,0 +1,411 @@
+#ifndef LITE_STATIC_BCH_H
+#define LITE_STATIC_BCH_H
+
+#if !(__cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L))
+#error "litebch/StaticBCH.h requires C++14 (constexpr table generation)"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time specialized BCH codec.
+//
+// StaticBCH<M, T> is the fixed-geometry counterpart of LiteBCH(2^M - 1, T)
+// with the default primitive polynomial: same codeword layout, same ECC
+// bytes, same decode() results. Its Galois field, generator polynomial and
+// lookup tables are constexpr objects, so there is no construction cost, and
+// every encoder / syndrome loop has a compile-time trip count.
+//
+// Header-only; requires C++14. Large codes need a few hundred thousand
+// constexpr evaluation steps per table (raise -fconstexpr-steps on Clang or
+// -fconstexpr-ops-limit on GCC if the compiler gives up).
+
+namespace lite {
+namespace detail {
+
+// Default primitive polynomials (bit i = coefficient of x^i), the same
+// choice as LiteBCHCode::default_polynomial.
+constexpr uint32_t static_bch_poly(int m) {
+  return m == 3    ? 0x0000B
+         : m == 4  ? 0x00013
+         : m == 5  ? 0x00025
+         : m == 6  ? 0x00043
+         : m == 7  ? 0x00083
+         : m == 8  ? 0x00171
+         : m == 9  ? 0x00211
+         : m == 10 ? 0x00409
+         : m == 11 ? 0x00805
+         : m == 12 ? 0x01099
+         : m == 13 ? 0x0201B
+         : m == 14 ? 0x05803
+         : m == 15 ? 0x08003
+         : m == 16 ? 0x1002D
+                   : 0;
+}
+
+// Degree of the generator polynomial: the number of distinct conjugates of
+// alpha^1 .. alpha^2t.
+template <int M> constexpr int static_bch_redundancy(int t) {
+  constexpr int N = (1 << M) - 1;
+  bool root[N] = {};
+  int r = 0;
+  for (int i = 1; i <= 2 * t; ++i)
+    for (int c = i; !root[c]; c = 2 * c % N) {
+      root[c] = true;
+      ++r;
+    }
+  return r;
+}
+
+// GF(2^M) in the layout of LiteBCHCode: alpha_to has 2N entries so a sum of
+// two logs needs no reduction, index_of[0] = 0xFFFF.
+template <int M> struct StaticField {
+  static constexpr int N = (1 << M) - 1;
+  uint16_t alpha_to[2 * N];
+  uint16_t index_of[N + 1];
+
+  constexpr StaticField() : alpha_to{}, index_of{} {
+    uint32_t x = 1;
+    for (int i = 0; i < N; ++i) {
+      alpha_to[i] = alpha_to[i + N] = (uint16_t)x;
+      index_of[x] = (uint16_t)i;
+      x <<= 1;
+      if (x >> M)
+        x ^= static_bch_poly(M);
+    }
+    index_of[0] = 0xFFFF;
+  }
+};
+
+// Binary generator polynomial g(x), g[R] = 1.
+template <int M, int T> struct StaticGenerator {
+  static constexpr int N = (1 << M) - 1;
+  static constexpr int R = static_bch_redundancy<M>(T);
+  uint8_t g[R + 1];
+
+  constexpr explicit StaticGenerator(const StaticField<M> &gf) : g{} {
+    // g(x) = prod (x + alpha^z) over the conjugates z, in polynomial form.
+    uint16_t p[R + 1] = {};
+    bool root[N] = {};
+    p[0] = 1;
+    int deg = 0;
+    for (int i = 1; i <= 2 * T; ++i)
+      for (int z = i; !root[z]; z = 2 * z % N) {
+        root[z] = true;
+        ++deg;
+        for (int k = deg; k >= 0; --k) {
+          uint16_t prod = p[k] ? gf.alpha_to[gf.index_of[p[k]] + z] : 0;
+          p[k] = (uint16_t)((k ? p[k - 1] : 0) ^ prod);
+        }
+      }
+    for (int k = 0; k <= R; ++k)
+      g[k] = (uint8_t)(p[k] & 1);
+  }
+};
+
+// Slice-by-4 encoder tables, MSB-aligned remainder of W words (see
+// LiteBCHCode::init_encode_tables): lut[k][b] = b(x) * x^(8k + R) mod g.
+template <int M, int T> struct StaticEncodeTable {
+  static constexpr int R = StaticGenerator<M, T>::R;
+  static constexpr int W = (R + 31) / 32;
+  uint32_t lut[4][256][W];
+
+  constexpr explicit StaticEncodeTable(const StaticGenerator<M, T> &gen)
+      : lut{} {
+    uint32_t gpoly[W] = {};
+    for (int j = 0; j < R; ++j)
+      if (gen.g[j]) {
+        int pos = R - 1 - j;
+        gpoly[pos / 32] |= 1U << (31 - pos % 32);
+      }
+
+    for (int b = 0; b < 256; ++b) {
+      uint32_t *rem = lut[0][b];
+      for (int bit = 7; bit >= 0; --bit) {
+        uint32_t feedback = ((uint32_t)(b >> bit) ^ (rem[0] >> 31)) & 1;
+        for (int w = 0; w < W - 1; ++w)
+          rem[w] = (rem[w] << 1) | (rem[w + 1] >> 31);
+        rem[W - 1] <<= 1;
+        if (feedback)
+          for (int w = 0; w < W; ++w)
+            rem[w] ^= gpoly[w];
+      }
+    }
+
+    for (int k = 1; k < 4; ++k)
+      for (int b = 0; b < 256; ++b) {
+        const uint32_t *prev = lut[k - 1][b];
+        const uint32_t *mask = lut[0][prev[0] >> 24];
+        uint32_t *rem = lut[k][b];
+        for (int w = 0; w < W - 1; ++w)
+          rem[w] = ((prev[w] << 8) | (prev[w + 1] >> 24)) ^ mask[w];
+        rem[W - 1] = (prev[W - 1] << 8) ^ mask[W - 1];
+      }
+  }
+};
+
+// Odd syndrome byte tables: lut[j][b] = sum over bits p of b of
+// alpha^((2j + 1) p), and step[j] = log of alpha^(8 (2j + 1)).
+template <int M, int T> struct StaticSyndromeTable {
+  static constexpr int N = (1 << M) - 1;
+  uint16_t lut[T][256];
+  uint16_t step[T];
+
+  constexpr explicit StaticSyndromeTable(const StaticField<M> &gf)
+      : lut{}, step{} {
+    for (int j = 0; j < T; ++j) {
+      int i = 2 * j + 1;
+      step[j] = (uint16_t)(8 * i % N);
+      for (int b = 0; b < 256; ++b) {
+        uint16_t v = 0;
+        for (int p = 0; p < 8; ++p)
+          if ((b >> p) & 1)
+            v ^= gf.alpha_to[i * p % N];
+        lut[j][b] = v;
+      }
+    }
+  }
+};
+
+template <int M, int T> struct StaticTables {
+  static constexpr StaticField<M> gf{};
+  static constexpr StaticGenerator<M, T> gen{gf};
+  static constexpr StaticEncodeTable<M, T> enc{gen};
+  static constexpr StaticSyndromeTable<M, T> syn{gf};
+};
+
+template <int M, int T> constexpr StaticField<M> StaticTables<M, T>::gf;
+template <int M, int T>
+constexpr StaticGenerator<M, T> StaticTables<M, T>::gen;
+template <int M, int T>
+constexpr StaticEncodeTable<M, T> StaticTables<M, T>::enc;
+template <int M, int T>
+constexpr StaticSyndromeTable<M, T> StaticTables<M, T>::syn;
+
+} // namespace detail
+
+template <int M, int T> class StaticBCH {
+  static_assert(M >= 3 && M <= 16, "StaticBCH supports 3 <= M <= 16");
+  static_assert(T >= 1 && M * T < (1 << M) - 1, "T too large for GF(2^M)");
+
+  using Tables = detail::StaticTables<M, T>;
+
+public:
+  static constexpr int N = (1 << M) - 1;
+  static constexpr int ecc_bits = detail::StaticGenerator<M, T>::R;
+  static constexpr int K = N - ecc_bits;
+  static constexpr int ecc_bytes = (ecc_bits + 7) / 8;
+  static constexpr int data_bytes = (K + 7) / 8;
+
+  static constexpr int get_N() { return N; }
+  static constexpr int get_K() { return K; }
+  static constexpr int get_t() { return T; }
+  static constexpr int get_ecc_bytes() { return ecc_bytes; }
+
+  // Same contract as LiteBCH::encode: data holds min(K, 8 * len) bits
+  // MSB-first, len < data_bytes being a shortened codeword; ecc_out receives
+  // ecc_bytes bytes. Unlike LiteBCH, a len above data_bytes is not an error
+  // (the extra bytes are ignored).
+  void encode(const uint8_t *data, size_t len, uint8_t *ecc_out) const {
+    constexpr int W = detail::StaticEncodeTable<M, T>::W;
+    const auto &lut = Tables::enc.lut;
+    uint32_t s[W] = {};
+
+    const int bits = data_bits(len);
+    const int full_bytes = bits / 8;
+    const int rem_bits = bits % 8;
+    int i = 0;
+    for (; i + 4 <= full_bytes; i += 4) {
+      uint32_t feedback = s[0] ^ (((uint32_t)data[i] << 24) |
+                                  ((uint32_t)data[i + 1] << 16) |
+                                  ((uint32_t)data[i + 2] << 8) | data[i + 3]);
+      const uint32_t *p0 = lut[0][feedback & 0xff];
+      const uint32_t *p1 = lut[1][(feedback >> 8) & 0xff];
+      const uint32_t *p2 = lut[2][(feedback >> 16) & 0xff];
+      const uint32_t *p3 = lut[3][feedback >> 24];
+      for (int w = 0; w < W - 1; ++w)
+        s[w] = s[w + 1] ^ p0[w] ^ p1[w] ^ p2[w] ^ p3[w];
+      s[W - 1] = p0[W - 1] ^ p1[W - 1] ^ p2[W - 1] ^ p3[W - 1];
+    }
+    for (; i < full_bytes; ++i)
+      shift_in(s, 8, (uint8_t)((s[0] >> 24) ^ data[i]));
+    if (rem_bits > 0)
+      shift_in(s, rem_bits,
+               (uint8_t)((s[0] >> (32 - rem_bits)) ^
+                         (data[full_bytes] >> (8 - rem_bits))));
+
+    // ecc bit i holds coefficient x^i (LSB packed)
+    constexpr int pad = 32 * W - ecc_bits;
+    for (int b = 0; b < ecc_bytes; ++b) {
+      int bit = pad + 8 * b;
+      int w = W - 1 - bit / 32;
+      int sh = bit % 32;
+      uint32_t v = s[w] >> sh;
+      if (sh > 24 && w > 0)
+        v |= s[w - 1] << (32 - sh);
+      ecc_out[b] = (uint8_t)v;
+    }
+  }
+
+  // Same contract as LiteBCH::decode: corrects data and ecc in-place and
+  // returns the number of errors corrected, or -1 if uncorrectable.
+  int decode(uint8_t *data, size_t len, uint8_t *ecc) const {
+    const auto &gf = Tables::gf;
+    const int bits = data_bits(len);
+
+    // Remainder of the received word modulo g
+    uint8_t rem[ecc_bytes];
+    encode(data, len, rem);
+    uint8_t diff = 0;
+    for (int i = 0; i < ecc_bytes; ++i) {
+      rem[i] ^= ecc[i];
+      diff |= rem[i];
+    }
+    if (ecc_bits % 8) {
+      diff = 0;
+      rem[ecc_bytes - 1] &= (1 << (ecc_bits % 8)) - 1;
+      for (int i = 0; i < ecc_bytes; ++i)
+        diff |= rem[i];
+    }
+    if (!diff)
+      return 0;
+
+    // Syndromes (polynomial form), highest degree byte first
+    int s[2 * T + 1] = {};
+    for (int k = ecc_bytes - 1; k >= 0; --k) {
+      const uint8_t b = rem[k];
+      for (int j = 0; j < T; ++j) {
+        int v = s[2 * j + 1];
+        if (v)
+          v = gf.alpha_to[gf.index_of[v] + Tables::syn.step[j]];
+        s[2 * j + 1] = v ^ Tables::syn.lut[j][b];
+      }
+    }
+    for (int i = 2; i <= 2 * T; i += 2)
+      s[i] = s[i / 2] ? gf.alpha_to[2 * gf.index_of[s[i / 2]]] : 0;
+
+    int lambda[2 * T + 1];
+    int deg = berlekamp_massey(s, lambda);
+    if (deg < 0)
+      return -1;
+
+    int loc[T];
+    if (find_roots(lambda, deg, ecc_bits + bits, loc) != deg)
+      return -1;
+
+    for (int i = 0; i < deg; ++i) {
+      if (loc[i] >= ecc_bits) {
+        int pos = bits - 1 - (loc[i] - ecc_bits); // MSB-first stream position
+        data[pos / 8] ^= (uint8_t)(0x80 >> (pos % 8));
+      } else {
+        ecc[loc[i] / 8] ^= (uint8_t)(1 << (loc[i] % 8));
+      }
+    }
+    return deg;
+  }
+
+private:
+  static int data_bits(size_t len) {
+    return len * 8 < (size_t)K ? (int)(len * 8) : K;
+  }
+
+  // Shifts n <= 8 bits into the MSB-aligned remainder; feedback holds them.
+  static void shift_in(uint32_t *s, int n, uint8_t feedback) {
+    constexpr int W = detail::StaticEncodeTable<M, T>::W;
+    for (int w = 0; w < W - 1; ++w)
+      s[w] = (s[w] << n) | (s[w + 1] >> (32 - n));
+    s[W - 1] <<= n;
+    const uint32_t *mask = Tables::enc.lut[0][feedback];
+    for (int w = 0; w < W; ++w)
+      s[w] ^= mask[w];
+  }
+
+  // Berlekamp-Massey for a binary code: the discrepancy of every second
+  // step is zero, so only T steps are run. lambda receives the connection
+  // polynomial in polynomial form; returns its degree, or -1 if > T.
+  static int berlekamp_massey(const int *s, int *lambda) {
+    const auto &gf = Tables::gf;
+    int b_poly[2 * T + 1] = {};
+    for (int i = 0; i <= 2 * T; ++i)
+      lambda[i] = 0;
+    lambda[0] = b_poly[0] = 1;
+    int L = 0, shift = 1, b = 1;
+
+    for (int n = 0; n < 2 * T; n += 2) {
+      int d = s[n + 1];
+      for (int i = 1; i <= L; ++i)
+        if (lambda[i] && s[n + 1 - i])
+          d ^= gf.alpha_to[gf.index_of[lambda[i]] +
+                           gf.index_of[s[n + 1 - i]]];
+      if (!d) {
+        shift += 2;
+        continue;
+      }
+
+      // lambda -= (d / b) x^shift B
+      int coef = gf.index_of[d] + N - gf.index_of[b];
+      if (coef >= N)
+        coef -= N;
+      int prev[2 * T + 1];
+      bool grow = 2 * L <= n;
+      if (grow)
+        for (int i = 0; i <= 2 * T; ++i)
+          prev[i] = lambda[i];
+      for (int i = 0; i + shift <= 2 * T; ++i)
+        if (b_poly[i])
+          lambda[i + shift] ^= gf.alpha_to[gf.index_of[b_poly[i]] + coef];
+
+      if (grow) {
+        L = n + 1 - L;
+        for (int i = 0; i <= 2 * T; ++i)
+          b_poly[i] = prev[i];
+        b = d;
+        shift = 2;
+      } else {
+        shift += 2;
+      }
+      if (L > T)
+        return -1;
+    }
+    return L;
+  }
+
+  // Degrees of the error positions: lambda(alpha^-loc) = 0. Returns the
+  // number of roots found among the n_bits lowest codeword degrees.
+  static int find_roots(const int *lambda, int deg, int n_bits, int *loc) {
+    const auto &gf = Tables::gf;
+    if (deg == 1) {
+      if (!lambda[1])
+        return 0;
+      loc[0] = gf.index_of[lambda[1]];
+      return loc[0] < n_bits ? 1 : 0;
+    }
+
+    // Chien search: reg[j] = log(lambda_j alpha^(i j)) at step i.
+    // Starts at i = N - n_bits + 1, the highest degree in the window.
+    const int first = N - n_bits + 1;
+    int reg[T + 1];
+    for (int j = 1; j <= deg; ++j)
+      reg[j] = lambda[j]
+                   ? (int)((gf.index_of[lambda[j]] + (int64_t)j * (first - 1)) % N)
+                   : -1;
+    int count = 0;
+    for (int i = first; i <= N && count < deg; ++i) {
+      int q = 1;
+      for (int j = 1; j <= deg; ++j)
+        if (reg[j] >= 0) {
+          reg[j] += j;
+          if (reg[j] >= N)
+            reg[j] -= N;
+          q ^= gf.alpha_to[reg[j]];
+        }
+      if (!q)
+        loc[count++] = N - i;
+    }
+    return count;
+  }
+};
+
+} // namespace lite
+
+#endif // LITE_STATIC_BCH_H
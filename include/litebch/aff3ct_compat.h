@@ -2,7 +2,10 @@
 #define AFF3CT_COMPAT_H
 
 #include <litebch/LiteBCH.h>
+#include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 // Compatibility Shim for aff3ct -> LiteBCH
@@ -19,7 +22,7 @@ public:
       : N(N), t(t), p(p) {
     // We create a temporary LiteBCH just to calculate K/redundancy correctly
     // avoiding duplicate logic.
-    lite::LiteBCH temp(N, t, p);
+    lite::LiteBCH temp(N, t, std::vector<int>(p.begin(), p.end()));
     n_rdncy = N - temp.get_K();
   }
 
@@ -37,37 +40,67 @@ private:
 
 namespace module {
 
+namespace detail {
+// int bits go to LiteBCH as they are; other bit types through 'buf'
+inline const int *in_bits(const int *p, size_t, std::vector<int> &) {
+  return p;
+}
+template <typename B>
+const int *in_bits(const B *p, size_t n, std::vector<int> &buf) {
+  buf.assign(p, p + n);
+  return buf.data();
+}
+inline int *out_bits(int *p, size_t, std::vector<int> &) { return p; }
+template <typename B> int *out_bits(B *, size_t n, std::vector<int> &buf) {
+  buf.resize(n);
+  return buf.data();
+}
+// float LLRs go to LiteBCH as they are; other reliability types through 'buf'
+inline const float *in_llrs(const float *p, size_t, std::vector<float> &) {
+  return p;
+}
+template <typename R>
+const float *in_llrs(const R *p, size_t n, std::vector<float> &buf) {
+  buf.assign(p, p + n);
+  return buf.data();
+}
+inline void copy_back(const int *, int *, size_t) {}
+template <typename B> void copy_back(const int *buf, B *p, size_t n) {
+  std::copy(buf, buf + n, p);
+}
+} // namespace detail
+
 // Mimics Encoder_BCH
 template <typename B = int> class Encoder_BCH {
 public:
   Encoder_BCH(int K, int N,
               const tools::BCH_polynomial_generator<B> &poly_gen) {
     // Instantiate the real worker
-    bch =
-        std::make_shared<lite::LiteBCH>(N, poly_gen.get_t(), poly_gen.get_p());
+    const auto &p = poly_gen.get_p();
+    bch = std::make_shared<lite::LiteBCH>(N, poly_gen.get_t(),
+                                          std::vector<int>(p.begin(), p.end()));
   }
 
   // Support both std::vector and mipp::vector (via template or implicit conv)
+  // X_N = [parity | U_K] is written in place through the packed byte
+  // encoder; it is only resized when its size is not N.
   template <typename Alloc>
   void encode(const std::vector<B, Alloc> &U_K, std::vector<B, Alloc> &X_N) {
-    // LiteBCH returns vector, aff3ct writes to reference.
-    // We convert/copy.
-
-    // 1. Adapter: copy input to std::vector (if needed, or just use const ref)
-    // std::vector cast is compatible for standard allocators.
-    std::vector<B> msg(U_K.begin(), U_K.end());
-
-    // 2. Perform
-    std::vector<B> encoded = bch->encode(msg);
-
-    // 3. Copy back
-    if (X_N.size() != encoded.size())
-      X_N.resize(encoded.size());
-    std::copy(encoded.begin(), encoded.end(), X_N.begin());
+    const int K = bch->get_K(), N = bch->get_N();
+    if (U_K.size() != (size_t)K)
+      throw std::invalid_argument("Message size must be K=" +
+                                  std::to_string(K));
+    if (X_N.size() != (size_t)N)
+      X_N.resize(N);
+    const int *u = detail::in_bits(U_K.data(), K, in_buf);
+    int *x = detail::out_bits(X_N.data(), N, out_buf);
+    bch->encode_bits(u, x);
+    detail::copy_back(x, X_N.data(), N);
   }
 
 private:
   std::shared_ptr<lite::LiteBCH> bch;
+  std::vector<int> in_buf, out_buf; // only used when B is not int
 };
 
 // Mimics Decoder_BCH_std / Decoder_BCH_fast
@@ -75,32 +108,62 @@ template <typename B = int, typename R = float> class Decoder_BCH_std {
 public:
   Decoder_BCH_std(int K, int N,
                   const tools::BCH_polynomial_generator<B> &poly_gen) {
-    bch =
-        std::make_shared<lite::LiteBCH>(N, poly_gen.get_t(), poly_gen.get_p());
+    const auto &p = poly_gen.get_p();
+    bch = std::make_shared<lite::LiteBCH>(N, poly_gen.get_t(),
+                                          std::vector<int>(p.begin(), p.end()));
   }
 
   // decode_hiho (Hard Input Hard Output)
+  // Writes the message bits to V_K (resized only when its size is not K);
+  // uncorrectable words give the received message bits, as in aff3ct.
   // Returns: Status (0 = success, !0 = fail)
   template <typename Alloc>
   int decode_hiho(const std::vector<B, Alloc> &Y_N,
                   std::vector<B, Alloc> &V_K) {
-    // 1. Adapter
-    std::vector<B> received(Y_N.begin(), Y_N.end());
-    std::vector<B> decoded;
-
-    // 2. Perform
-    bool success = bch->decode(received, decoded);
+    const int K = bch->get_K(), N = bch->get_N();
+    if (Y_N.size() != (size_t)N)
+      return 1;
+    if (V_K.size() != (size_t)K)
+      V_K.resize(K);
+    const int *y = detail::in_bits(Y_N.data(), N, in_buf);
+    int *v = detail::out_bits(V_K.data(), K, out_buf);
+    int count = bch->decode_bits(y, v);
+    detail::copy_back(v, V_K.data(), K);
+    return count >= 0 ? 0 : 1; // 0 is success in aff3ct
+  }
 
-    // 3. Copy back
-    if (V_K.size() != decoded.size())
-      V_K.resize(decoded.size());
-    std::copy(decoded.begin(), decoded.end(), V_K.begin());
+  // decode_siho (Soft Input Hard Output)
+  // Chase-II over the LLRs Y_N (negative = bit 1, as in aff3ct), flipping
+  // the n_least_reliable_positions() least reliable bits in every
+  // combination. Same output and status as decode_hiho.
+  template <typename AllocR, typename AllocB>
+  int decode_siho(const std::vector<R, AllocR> &Y_N,
+                  std::vector<B, AllocB> &V_K) {
+    const int K = bch->get_K(), N = bch->get_N();
+    if (Y_N.size() != (size_t)N)
+      return 1;
+    if (V_K.size() != (size_t)K)
+      V_K.resize(K);
+    const float *y = detail::in_llrs(Y_N.data(), N, llr_buf);
+    int *v = detail::out_bits(V_K.data(), K, out_buf);
+    int count = bch->decode_chase_bits(y, v, n_lrp);
+    detail::copy_back(v, V_K.data(), K);
+    return count >= 0 ? 0 : 1;
+  }
 
-    return success ? 0 : 1; // 0 is success in aff3ct
+  // Test patterns of decode_siho: 2^p for p positions, p <= 16 (default 4)
+  void set_n_least_reliable_positions(int p) {
+    if (p < 0 || p > lite::LiteBCHCode::max_chase_positions)
+      throw std::invalid_argument("Chase positions must be in [0, 16]");
+    n_lrp = p;
   }
+  int get_n_least_reliable_positions() const { return n_lrp; }
 
 private:
   std::shared_ptr<lite::LiteBCH> bch;
+  std::vector<int> in_buf, out_buf; // only used when B is not int
+  std::vector<float> llr_buf;       // only used when R is not float
+  int n_lrp = 4;
 };
 
 // Alias Fast decoder to Std (LiteBCH is fast enough)
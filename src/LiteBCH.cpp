@@ -1,21 +1,65 @@
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <litebch/LiteBCH.h>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <tuple>
+
+#include "simd/kernels.h"
+
+#if defined(LITEBCH_STATS)
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+// Decoder instrumentation (see LiteBCHCode::DecodeStats): compiled out
+// entirely unless LITEBCH_STATS is defined.
+#define LITEBCH_STAT(stmt) stmt
+#else
+#define LITEBCH_STAT(stmt) ((void)0)
+#endif
 
 namespace lite {
 
-LiteBCH::LiteBCH(int N, int t, std::vector<I> p) : N(N), t(t), d(2 * t + 1) {
+#if defined(LITEBCH_STATS)
+namespace {
+// Cycle counter of the stage timers
+inline uint64_t stat_clock() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) ||            \
+    defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t v;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+#else
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+} // namespace
+#endif
+
+LiteBCHCode::LiteBCHCode(int N, int t, std::vector<I> p, TableMode tables)
+    : N(N), t(t), d(2 * t + 1) {
   m = (int)std::ceil(std::log2(N));
   if (N != ((1 << m) - 1)) {
     throw std::invalid_argument("N must be 2^m - 1");
   }
+  if (m < 3 || m > 24)
+    throw std::invalid_argument("N must be 2^m - 1 with 3 <= m <= 24");
+  // The roots alpha^1 .. alpha^2t must be distinct non-zero elements
+  if (t < 1 || 2 * t >= N)
+    throw std::invalid_argument("t must be in [1, (N - 1) / 2]");
 
   // 1. Initialize Galois Field
-  alpha_to.resize(N + 1);
-  index_of.resize(N + 1);
-
   if (!p.empty()) {
     if ((int)p.size() != m + 1) {
       throw std::invalid_argument(
@@ -23,11 +67,16 @@ LiteBCH::LiteBCH(int N, int t, std::vector<I> p) : N(N), t(t), d(2 * t + 1) {
     }
     this->p = p;
   } else {
-    this->p.resize(m + 1, 0); // Primitive polynomial coeffs
-    select_polynomial();
+    this->p = default_polynomial(m);
   }
 
-  init_galois();
+  if (wide()) {
+    init_wide_field();
+  } else {
+    alpha_to.resize(2 * N);
+    index_of.resize(N + 1);
+    init_galois();
+  }
 
   // 2. Compute Generator Polynomial
   compute_generator_polynomial();
@@ -36,32 +85,399 @@ LiteBCH::LiteBCH(int N, int t, std::vector<I> p) : N(N), t(t), d(2 * t + 1) {
   n_rdncy = g.size() - 1;
   K = N - n_rdncy;
 
-  // 4. Init Fast Encoding Tables
+  // 4. Init Fast Encoding / Decoding Tables (or leave them to first use)
   ecc_bits = N - K;
   ecc_words = (ecc_bits + 31) / 32;
   ecc_bytes = (ecc_bits + 7) / 8;
-  init_fast_tables();
+  if (tables == TableMode::Eager) {
+    need_encoder();
+    need_lanes();
+    need_decoder();
+  }
+}
+
+void LiteBCHCode::build_stage(Stage &stage,
+                              void (LiteBCHCode::*init)() const) const {
+  std::lock_guard<std::mutex> lock(stage.lock);
+  if (stage.ready.load(std::memory_order_relaxed))
+    return;
+  (this->*init)();
+  stage.ready.store(true, std::memory_order_release);
+}
+
+// ==========================================
+// Memory Usage
+// ==========================================
+
+namespace {
+
+template <class V> size_t bytes_of(const V &v) {
+  return v.capacity() * sizeof(v[0]);
+}
+
+} // namespace
+
+LiteBCHCode::MemoryUsage LiteBCHCode::memory_usage() const {
+  MemoryUsage usage;
+  usage.gf = bytes_of(alpha_to) + bytes_of(index_of) + bytes_of(p) +
+             bytes_of(g);
+  if (encoder_stage.ready.load(std::memory_order_acquire))
+    usage.encoder += bytes_of(encode_tab) + bytes_of(clmul_tab);
+  if (lanes_stage.ready.load(std::memory_order_acquire))
+    usage.encoder += bytes_of(encode_nib_tab);
+  if (shift_stage.ready.load(std::memory_order_acquire))
+    usage.encoder += bytes_of(shift_tab);
+  usage.gf += bytes_of(wide_reduce);
+  if (decoder_stage.ready.load(std::memory_order_acquire))
+    usage.decoder = bytes_of(syndrome_lut) + bytes_of(alpha_8_pow) +
+                    bytes_of(syndrome_tab) + bytes_of(chien_tab) +
+                    bytes_of(wide_syn_lut) + bytes_of(wide_syn_step) +
+                    bytes_of(wide_chien) + bytes_of(wide_giant) +
+                    bytes_of(wide_baby);
+  return usage;
+}
+
+size_t LiteBCHCode::Workspace::memory_usage() const {
+  return bytes_of(par) + bytes_of(calc_ecc) + bytes_of(wide) +
+         bytes_of(bits) + bytes_of(enc_planes) + bytes_of(s) +
+         bytes_of(lambda) + bytes_of(bm_b) + bytes_of(bm_prev) +
+         bytes_of(loc) + bytes_of(reg) + bytes_of(chien_lo) +
+         bytes_of(chien_hi) + bytes_of(chase_syn) + bytes_of(chase_best) +
+         bytes_of(chase_hard) + bytes_of(side);
+}
+
+LiteBCHCode::Workspace::Workspace(const LiteBCH &bch) {
+  prepare(*bch.get_code());
+}
+
+void LiteBCHCode::Workspace::prepare(const LiteBCHCode &code) {
+  const int kern_lanes = simd::active_kernels().lanes;
+  if (t == code.t && ecc_words == code.ecc_words &&
+      ecc_bytes == code.ecc_bytes && lanes == kern_lanes && k == code.K)
+    return;
+  t = code.t;
+  ecc_words = code.ecc_words;
+  ecc_bytes = code.ecc_bytes;
+  lanes = kern_lanes;
+  k = code.K;
+
+  par.resize(ecc_words);
+  calc_ecc.resize(ecc_bytes);
+  bits.clear(); // Sized by the bit API on first use: K / 8 bytes
+  wide.resize((ecc_words + 1) / 2);
 
-  // 5. Init Decoder Buffers
-  // Optimized for scalability: elp only needs 2*t history
-  int t2 = 2 * t;
-  elp.resize(t2 + 5, std::vector<int>(N + 1)); // 2nd dim could be smaller but N
-                                               // is safe upper bound for sparse
-  discrepancy.resize(t2 + 5);
-  l.resize(t2 + 5);
-  u_lu.resize(t2 + 5);
   s.resize(2 * t + 1);
+  lambda.resize(t + 1);
+  bm_b.resize(t + 1);
+  bm_prev.resize(t + 1);
   loc.resize(t + 1);
   reg.resize(t + 1);
 
-  reg.resize(t + 1);
+  chien_lo.resize(t * lanes);
+  chien_hi.resize(t * lanes);
+  enc_planes.resize(4 * ecc_words * lanes);
+  stat.errors.resize(t + 1);
+}
+
+// --- Decoder Statistics ---
+bool LiteBCHCode::stats_enabled() {
+#if defined(LITEBCH_STATS)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void LiteBCHCode::DecodeStats::merge(const DecodeStats &o) {
+  decoded += o.decoded;
+  clean += o.clean;
+  corrected += o.corrected;
+  failed += o.failed;
+  if (errors.size() < o.errors.size())
+    errors.resize(o.errors.size());
+  for (size_t k = 0; k < o.errors.size(); ++k)
+    errors[k] += o.errors[k];
+  for (int i = 0; i < n_stages; ++i)
+    cycles[i] += o.cycles[i];
+}
+
+void LiteBCHCode::Workspace::reset_stats() {
+  size_t bins = stat.errors.size();
+  stat = DecodeStats();
+  stat.errors.resize(bins);
+}
+
+// A word is stat_begin(), stat_lap() after each stage it runs (a stage
+// run several times, as in Chase and erasure decoding, adds up), then
+// stat_end(). Only plain members of this Workspace are touched.
+void LiteBCHCode::Workspace::stat_begin() {
+#if defined(LITEBCH_STATS)
+  for (int i = 0; i < DecodeStats::n_stages; ++i)
+    word_cycles[i] = 0;
+  lap_start = stat_clock();
+#endif
+}
+
+void LiteBCHCode::Workspace::stat_lap(DecodeStats::Stage stage) {
+#if defined(LITEBCH_STATS)
+  uint64_t now = stat_clock();
+  word_cycles[stage] += now - lap_start;
+  stat.cycles[stage] += now - lap_start;
+  lap_start = now;
+#else
+  (void)stage;
+#endif
+}
+
+void LiteBCHCode::Workspace::stat_end(int result, size_t len) {
+#if defined(LITEBCH_STATS)
+  stat.decoded++;
+  if (result < 0) {
+    stat.failed++;
+  } else {
+    (result ? stat.corrected : stat.clean)++;
+    if ((size_t)result < stat.errors.size())
+      stat.errors[result]++;
+  }
+  if (trace) {
+    TraceEvent ev = {len, result, word_cycles};
+    trace(trace_user, ev);
+  }
+#else
+  (void)result;
+  (void)len;
+#endif
+}
+
+LiteBCH::LiteBCH(int N, int t, std::vector<I> p, TableMode tables)
+    : code(std::make_shared<LiteBCHCode>(N, t, std::move(p), tables)),
+      default_ws(*code) {}
+
+LiteBCH::LiteBCH(std::shared_ptr<const LiteBCHCode> code)
+    : code(std::move(code)) {
+  if (!this->code)
+    throw std::invalid_argument("LiteBCH requires a non-null code");
+  default_ws = Workspace(*this->code);
+}
+
+// ==========================================
+// Code Cache
+// ==========================================
+
+namespace {
+
+using CodeKey = std::tuple<int, int, std::vector<LiteBCHCode::I>>;
+
+std::mutex &cache_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<CodeKey, std::shared_ptr<const LiteBCHCode>> &code_cache() {
+  static std::map<CodeKey, std::shared_ptr<const LiteBCHCode>> cache;
+  return cache;
+}
+
+} // namespace
+
+std::shared_ptr<const LiteBCHCode> LiteBCHCode::get(int N, int t,
+                                                    std::vector<I> p) {
+  // Key the default polynomial explicitly so that get(N, t) and
+  // get(N, t, default_polynomial(m)) share one code. A bad N is reported by
+  // the constructor.
+  if (p.empty()) {
+    int m = 1;
+    while (m < 30 && (1 << m) - 1 < N)
+      m++;
+    p = default_polynomial(m);
+  }
+  CodeKey key(N, t, p);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex());
+    auto it = code_cache().find(key);
+    if (it != code_cache().end())
+      return it->second;
+  }
+
+  // Built without the lock so other geometries are not held up; if two
+  // threads race on the same key, the first insertion wins.
+  auto code = std::make_shared<const LiteBCHCode>(N, t, std::move(p));
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  return code_cache().emplace(std::move(key), std::move(code)).first->second;
+}
+
+void LiteBCHCode::preload(std::shared_ptr<const LiteBCHCode> code) {
+  if (!code)
+    throw std::invalid_argument("preload requires a non-null code");
+  CodeKey key(code->N, code->t, code->p);
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  code_cache()[std::move(key)] = std::move(code);
+}
+
+void LiteBCHCode::clear_cache() {
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  code_cache().clear();
+}
+
+// ==========================================
+// Table Serialization
+// ==========================================
+//
+// Blob layout (native byte order):
+//   "LBCH", version, byte order mark,
+//   N, t, m, d, n_rdncy, K, ecc_bits, ecc_words, ecc_bytes,
+//   p, g, alpha_to, index_of, encode_tab, encode_nib_tab, clmul_tab,
+//   syndrome_lut, alpha_8_pow, syndrome_tab, chien_tab
+//   (each: uint32 count, then the elements),
+//   FNV-1a hash of everything before it.
+// The SIMD tables do not depend on the instruction set, so a blob written by
+// one build loads in any other.
+
+namespace {
+
+const uint32_t kBlobVersion = 4;
+const uint32_t kByteOrderMark = 0x01020304;
+
+uint32_t fnv1a(const uint8_t *p, size_t n) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < n; ++i)
+    h = (h ^ p[i]) * 16777619u;
+  return h;
+}
+
+struct BlobWriter {
+  std::vector<uint8_t> out;
+
+  void raw(const void *p, size_t n) {
+    const uint8_t *b = static_cast<const uint8_t *>(p);
+    out.insert(out.end(), b, b + n);
+  }
+  void u32(uint32_t v) { raw(&v, sizeof(v)); }
+  template <class V> void array(const V &v) {
+    u32((uint32_t)v.size());
+    raw(v.data(), v.size() * sizeof(v[0]));
+  }
+};
+
+struct BlobReader {
+  const uint8_t *p;
+  size_t left;
+
+  void raw(void *dst, size_t n) {
+    if (n > left)
+      throw std::invalid_argument("LiteBCH table blob is truncated");
+    std::memcpy(dst, p, n);
+    p += n;
+    left -= n;
+  }
+  uint32_t u32() {
+    uint32_t v;
+    raw(&v, sizeof(v));
+    return v;
+  }
+  int i32() { return (int)u32(); }
+  template <class V> void array(V &v, size_t expected) {
+    if (u32() != expected)
+      throw std::invalid_argument("LiteBCH table blob has a bad table size");
+    v.resize(expected);
+    raw(v.data(), expected * sizeof(v[0]));
+  }
+};
+
+} // namespace
+
+std::vector<uint8_t> LiteBCHCode::serialize() const {
+  static_assert(sizeof(I) == 4, "blob stores polynomials as 32-bit ints");
+  need_encoder();
+  need_lanes();
+  need_decoder();
+  BlobWriter w;
+  w.raw("LBCH", 4);
+  w.u32(kBlobVersion);
+  w.u32(kByteOrderMark);
+  const int fields[] = {N,       t,        m,         d,        n_rdncy,
+                        K,       ecc_bits, ecc_words, ecc_bytes};
+  for (int f : fields)
+    w.u32((uint32_t)f);
+  w.array(p);
+  w.array(g);
+  w.array(alpha_to);
+  w.array(index_of);
+  w.array(encode_tab);
+  w.array(encode_nib_tab);
+  w.array(clmul_tab);
+  w.array(syndrome_lut);
+  w.array(alpha_8_pow);
+  w.array(syndrome_tab);
+  w.array(chien_tab);
+  w.u32(fnv1a(w.out.data(), w.out.size()));
+  return w.out;
+}
+
+std::shared_ptr<const LiteBCHCode>
+LiteBCHCode::deserialize(const uint8_t *blob, size_t size) {
+  if (!blob || size < 16 || std::memcmp(blob, "LBCH", 4) != 0)
+    throw std::invalid_argument("Not a LiteBCH table blob");
+  uint32_t hash;
+  std::memcpy(&hash, blob + size - 4, 4);
+  if (hash != fnv1a(blob, size - 4))
+    throw std::invalid_argument("LiteBCH table blob is corrupted");
+
+  BlobReader r = {blob + 4, size - 8};
+  if (r.u32() != kBlobVersion)
+    throw std::invalid_argument("Unsupported LiteBCH table blob version");
+  if (r.u32() != kByteOrderMark)
+    throw std::invalid_argument("LiteBCH table blob has another byte order");
+
+  std::shared_ptr<LiteBCHCode> code(new LiteBCHCode());
+  LiteBCHCode &c = *code;
+  c.N = r.i32();
+  c.t = r.i32();
+  c.m = r.i32();
+  c.d = r.i32();
+  c.n_rdncy = r.i32();
+  c.K = r.i32();
+  c.ecc_bits = r.i32();
+  c.ecc_words = r.i32();
+  c.ecc_bytes = r.i32();
+  if (c.m < 3 || c.m > 24 || c.N != (1 << c.m) - 1 || c.t < 1 ||
+      c.d != 2 * c.t + 1 || c.n_rdncy < 1 || c.n_rdncy >= c.N ||
+      c.K != c.N - c.n_rdncy || c.ecc_bits != c.n_rdncy ||
+      c.ecc_words != (c.ecc_bits + 31) / 32 ||
+      c.ecc_bytes != (c.ecc_bits + 7) / 8)
+    throw std::invalid_argument("LiteBCH table blob has bad dimensions");
+
+  // Wide fields store no field or decoder tables; those are rebuilt from
+  // p (cheap next to the encoder tables).
+  const bool narrow = !c.wide();
+  r.array(c.p, c.m + 1);
+  r.array(c.g, c.n_rdncy + 1);
+  r.array(c.alpha_to, narrow ? 2 * c.N : 0);
+  r.array(c.index_of, narrow ? c.N + 1 : 0);
+  r.array(c.encode_tab, 4 * 256 * c.ecc_words);
+  r.array(c.encode_nib_tab, 4 * c.ecc_words * 32);
+  r.array(c.clmul_tab, 3 + c.clmul_words());
+  r.array(c.syndrome_lut, narrow ? c.t * 256 : 0);
+  r.array(c.alpha_8_pow, narrow ? 2 * c.t + 1 : 0);
+  r.array(c.syndrome_tab, narrow ? c.t * sizeof(simd::SyndromeTable) : 0);
+  r.array(c.chien_tab, narrow ? c.t * sizeof(simd::MulTable) : 0);
+  if (r.left != 0)
+    throw std::invalid_argument("LiteBCH table blob has trailing data");
+  c.encoder_stage.ready = true;
+  c.lanes_stage.ready = true;
+  if (narrow)
+    c.decoder_stage.ready = true;
+  else
+    c.init_wide_field();
+  return code;
 }
 
 // ==========================================
 // Galois Field Logic (Masked form aff3ct/Tools/Math/Galois)
 // ==========================================
 
-void LiteBCH::select_polynomial() {
+std::vector<LiteBCHCode::I> LiteBCHCode::default_polynomial(int m) {
+  std::vector<I> p(m + 1, 0);
   p[0] = p[m] = 1;
   if (m == 3)
     p[1] = 1;
@@ -91,10 +507,27 @@ void LiteBCH::select_polynomial() {
     p[1] = 1;
   else if (m == 16)
     p[2] = p[3] = p[5] = 1;
-  // Add more if needed, supports up to m=16 for typical BCH use
+  else if (m == 17)
+    p[3] = 1;
+  else if (m == 18)
+    p[7] = 1;
+  else if (m == 19)
+    p[1] = p[2] = p[5] = 1;
+  else if (m == 20)
+    p[3] = 1;
+  else if (m == 21)
+    p[2] = 1;
+  else if (m == 22)
+    p[1] = 1;
+  else if (m == 23)
+    p[5] = 1;
+  else if (m == 24)
+    p[1] = p[2] = p[7] = 1;
+  // Wide fields (m > 16) are supported up to m = 24
+  return p;
 }
 
-void LiteBCH::init_galois() {
+void LiteBCHCode::init_galois() {
   int i, mask;
   mask = 1;
   alpha_to[m] = 0;
@@ -115,78 +548,82 @@ void LiteBCH::init_galois() {
     const auto idx = alpha_to[i];
     index_of[idx] = i;
   }
-  index_of[0] = -1;
+  index_of[0] = 0xFFFF; // log(0), see gf_log
+  for (i = N; i < 2 * N; i++)
+    alpha_to[i] = alpha_to[i - N];
 }
 
 // ==========================================
 // Generator Poly Logic (from BCH_polynomial_generator)
 // ==========================================
 
-void LiteBCH::compute_generator_polynomial() {
-  std::vector<std::vector<int>> cycle_sets(2, std::vector<int>(1));
-  cycle_sets[0][0] = 0;
-  cycle_sets[1][0] = 1;
-  int cycle_set_representative = 0;
-  bool test;
-  do {
-    auto &cycle_set = cycle_sets.back();
-    cycle_set.reserve(32);
-    do {
-      cycle_set.push_back((cycle_set.back() * 2) % N);
-    } while (((cycle_set.back() * 2) % N) != cycle_set.front());
+// Polynomial-form helpers; logs of non-zero elements are < N, so any sum of
+// two of them indexes alpha_to directly.
+inline int LiteBCHCode::gf_log(int a) const { return a ? index_of[a] : -1; }
 
-    do {
-      cycle_set_representative++;
-      test = false;
-      for (unsigned i = 1; (i < cycle_sets.size()) && !test; i++)
-        for (unsigned j = 0; (j < cycle_sets[i].size()) && !test; j++)
-          test = (cycle_set_representative == cycle_sets[i][j]);
-    } while (test && (cycle_set_representative < (N - 1)));
-
-    if (!test) {
-      cycle_sets.push_back(std::vector<int>(1, cycle_set_representative));
-    }
-  } while (cycle_set_representative < (N - 1));
-
-  int rdncy = 0;
-  std::vector<int> min;
-  for (unsigned i = 1; i < cycle_sets.size(); i++) {
-    test = false;
-    for (unsigned j = 0; (j < cycle_sets[i].size()) && !test; j++)
-      for (int root = 1; (root < d) && !test; root++)
-        if (root == cycle_sets[i][j]) {
-          test = true;
-          min.push_back((int)i);
-          rdncy += (int)cycle_sets[i].size();
-        }
-  }
+inline int LiteBCHCode::gf_mul(int a, int b) const {
+  return (a && b) ? alpha_to[index_of[a] + index_of[b]] : 0;
+}
 
-  std::vector<int> zeros(rdncy + 1);
-  int kaux = 1;
-  test = true;
-  for (unsigned i = 0; i < min.size() && test; i++)
-    for (unsigned j = 0; j < cycle_sets[min[i]].size() && test; j++) {
-      zeros[kaux] = cycle_sets[min[i]][j];
-      kaux++;
-      test = (kaux <= rdncy);
-    }
+inline int LiteBCHCode::gf_div(int a, int b) const {
+  return a ? alpha_to[index_of[a] + N - index_of[b]] : 0;
+}
 
-  g.resize(rdncy + 1);
-  g[0] = alpha_to[zeros[1]];
-  g[1] = 1;
-  for (int i = 2; i <= rdncy; i++) {
-    g[i] = 1;
-    for (int j = i - 1; j > 0; j--)
-      if (g[j] != 0)
-        g[j] = g[j - 1] ^ alpha_to[(index_of[g[j]] + zeros[i]) % N];
-      else
-        g[j] = g[j - 1];
-    g[0] = alpha_to[(index_of[g[0]] + zeros[i]) % N];
-  }
+inline int LiteBCHCode::gf_sqrt(int a) const {
+  if (!a)
+    return 0;
+  int e = index_of[a];
+  return alpha_to[(e & 1) ? (e + N) / 2 : e / 2]; // N is odd
+}
 
-  // Force binary coefficients (GF(2))
-  for (auto &val : g)
-    val &= 1;
+int LiteBCHCode::gf_alpha(int64_t e) const {
+  e %= N;
+  if (e < 0)
+    e += N;
+  return wide() ? (int)wide_pow(2, (uint64_t)e) : alpha_to[e];
+}
+
+void LiteBCHCode::compute_generator_polynomial() {
+  // g(x) is the product of the minimal polynomials of the roots alpha^1 ..
+  // alpha^(d-1). The minimal polynomial of alpha^r is the product of
+  // (x - alpha^z) over the cyclotomic coset {r, 2r, 4r, ...} mod N and has
+  // binary coefficients; a root starts a new coset unless a smaller one
+  // lies in its coset. Only the m-term cosets are multiplied in the field.
+  g.assign(1, 1);
+  std::vector<int> mp;
+  std::vector<I> prod;
+  for (int r = 1; r < d; r++) {
+    bool seen = false;
+    for (int64_t z = 2 * r % N; z != r; z = 2 * z % N)
+      if (z < r) {
+        seen = true;
+        break;
+      }
+    if (seen)
+      continue;
+
+    mp.assign(1, 1); // low degree first
+    int64_t z = r;
+    do {
+      const int a = gf_alpha(z);
+      mp.push_back(0);
+      for (size_t j = mp.size() - 1; j > 0; j--)
+        mp[j] = mp[j - 1] ^
+                (wide() ? (int)wide_mul((uint32_t)mp[j], (uint32_t)a)
+                        : gf_mul(mp[j], a));
+      mp[0] = wide() ? (int)wide_mul((uint32_t)mp[0], (uint32_t)a)
+                     : gf_mul(mp[0], a);
+      z = 2 * z % N;
+    } while (z != r);
+
+    // Force binary coefficients (GF(2))
+    prod.assign(g.size() + mp.size() - 1, 0);
+    for (size_t i = 0; i < g.size(); i++)
+      if (g[i])
+        for (size_t j = 0; j < mp.size(); j++)
+          prod[i + j] ^= mp[j] & 1;
+    g.swap(prod);
+  }
 }
 
 // ==========================================
@@ -194,69 +631,138 @@ void LiteBCH::compute_generator_polynomial() {
 // ==========================================
 
 // --- Fast Encoding Helpers ---
+//
+// The remainder is kept MSB-aligned in ecc_words 32-bit words: coefficient
+// x^j of the remainder lives at bit (ecc_bits - 1 - j) counted from the MSB of
+// word 0, and the (32 * ecc_words - ecc_bits) low bits of the last word stay
+// zero. With that alignment, shifting the remainder by a whole word is a plain
+// word move and the feedback for 32 input bits is simply the top word.
+
+static inline uint32_t load_be32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
 
-static uint8_t get_top_byte(const std::vector<uint32_t> &par, int n_bits) {
-  uint8_t res = 0;
-  for (int i = 0; i < 8; ++i) {
-    int bit_pos = n_bits - 8 + i;
-    if (bit_pos < 0)
-      continue;
-    int w = bit_pos / 32;
-    int b = bit_pos % 32;
-    if (par[w] & (1 << b)) {
-      res |= (1 << i);
-    }
-  }
-  return res;
+// Shift the aligned remainder left by n bits (1 <= n <= 8).
+static inline void shift_left_bits(uint32_t *par, int words, int n) {
+  for (int w = 0; w < words - 1; ++w)
+    par[w] = (par[w] << n) | (par[w + 1] >> (32 - n));
+  par[words - 1] <<= n;
 }
 
-static void shift_left_8(std::vector<uint32_t> &par, int words) {
-  uint32_t carry = 0;
-  for (int w = 0; w < words; ++w) {
-    uint32_t temp = par[w];
-    par[w] = (temp << 8) | carry;
-    carry = (temp >> 24);
+// Nibble tables multiplying by alpha^c, c < N (see simd/kernels.h).
+static void build_mul_table(simd::MulTable &tab, int c, int m,
+                            const uint16_t *alpha_to,
+                            const uint16_t *index_of) {
+  for (int k = 0; k < 4; ++k) {
+    for (int e = 0; e < 16; ++e) {
+      int x = e << (4 * k);
+      int prod = 0;
+      if (x && !(x >> m)) // Other nibbles are never looked up
+        prod = alpha_to[index_of[x] + c];
+      tab.t[k][e] = (uint8_t)prod;
+      tab.t[4 + k][e] = (uint8_t)(prod >> 8);
+    }
   }
 }
 
-void LiteBCH::init_fast_tables() {
-  encode_lut.resize(256, std::vector<uint32_t>(ecc_words, 0));
-
-  // Simulate 8-bit LFSR for every byte input
-  for (int i = 0; i < 256; ++i) {
-    // Temp remainder
-    std::vector<int> rem(ecc_bits, 0);
+// --- Encoder tables (slice-by-4 and carry-less multiply) ---
+void LiteBCHCode::init_encode_tables() const {
+  // encode_tab[k][b] = (b(x) * x^(8k) * x^ecc_bits) mod g, MSB-aligned.
+  // Slice k handles byte k of a 32-bit feedback word (k = 0 is the LSB).
+  encode_tab.assign(4 * 256 * ecc_words, 0);
+
+  // g without its leading term, MSB-aligned.
+  std::vector<uint32_t> gpoly(ecc_words, 0);
+  for (int j = 0; j < ecc_bits; ++j) {
+    if (g[j]) {
+      int pos = ecc_bits - 1 - j;
+      gpoly[pos / 32] |= 1U << (31 - pos % 32);
+    }
+  }
 
-    // Shift in byte 'i' (MSB first logic)
+  // Slice 0: bit-serial LFSR over each input byte, MSB first.
+  for (int b = 0; b < 256; ++b) {
+    uint32_t *rem = &encode_tab[b * ecc_words];
     for (int bit = 7; bit >= 0; --bit) {
-      int input = (i >> bit) & 1;
-      int feedback = input ^ rem[ecc_bits - 1]; // Fix: Include state feedback!
+      uint32_t feedback = ((uint32_t)(b >> bit) ^ (rem[0] >> 31)) & 1;
+      shift_left_bits(rem, ecc_words, 1);
+      if (feedback)
+        for (int w = 0; w < ecc_words; ++w)
+          rem[w] ^= gpoly[w];
+    }
+  }
 
-      // Shift and add g
-      for (int k = ecc_bits - 1; k > 0; --k) {
-        rem[k] = rem[k - 1] ^ (g[k] & feedback);
-      }
-      rem[0] = (g[0] ? feedback : 0);
+  // Slice k: slice k-1 followed by 8 zero input bits.
+  for (int k = 1; k < 4; ++k) {
+    for (int b = 0; b < 256; ++b) {
+      uint32_t *rem = &encode_tab[(k * 256 + b) * ecc_words];
+      const uint32_t *prev = &encode_tab[((k - 1) * 256 + b) * ecc_words];
+      std::copy(prev, prev + ecc_words, rem);
+      uint8_t feedback = (uint8_t)(rem[0] >> 24);
+      shift_left_bits(rem, ecc_words, 8);
+      const uint32_t *mask = &encode_tab[feedback * ecc_words];
+      for (int w = 0; w < ecc_words; ++w)
+        rem[w] ^= mask[w];
     }
+  }
 
-    // Pack into 32-bit words (Little-Endian: rem[0] -> bit 0)
-    for (int w = 0; w < ecc_words; ++w) {
-      uint32_t word = 0;
-      for (int b = 0; b < 32; ++b) {
-        int idx = w * 32 + b;
-        if (idx < ecc_bits) {
-          if (rem[idx])
-            word |= (1 << b);
-        }
-      }
-      encode_lut[i][w] = word;
+  // Carry-less multiply encoder: G = g * x^pad fills whole 64-bit words.
+  // Long division gives Q = floor(x^(r + 128) / g); mu_128 is Q without its
+  // x^128 term and mu_64 = floor(Q / x^64) without its x^64 term.
+  const int cw = clmul_words();
+  const int pad = 64 * cw - ecc_bits;
+  clmul_tab.assign(3 + cw, 0);
+  for (int j = 0; j < ecc_bits; ++j)
+    if (g[j])
+      clmul_tab[3 + (j + pad) / 64] |= 1ULL << ((j + pad) % 64);
+  std::vector<uint8_t> dividend(ecc_bits + 129, 0);
+  dividend[ecc_bits + 128] = 1;
+  for (int d = 128; d >= 0; --d) {
+    if (!dividend[ecc_bits + d])
+      continue;
+    if (d < 128)
+      clmul_tab[1 + d / 64] |= 1ULL << (d % 64);
+    if (d >= 64 && d < 128)
+      clmul_tab[0] |= 1ULL << (d - 64);
+    for (int j = 0; j <= ecc_bits; ++j)
+      dividend[j + d] ^= (uint8_t)g[j];
+  }
+}
+
+// --- Lockstep batch encoder tables ---
+void LiteBCHCode::init_lane_tables() const {
+  need_encoder();
+
+  // Lockstep encoder: slice 0 is linear in the feedback byte, so byte b of
+  // encode_tab[x] is the XOR of the entries of its two nibbles.
+  encode_nib_tab.assign(4 * ecc_words * 32, 0);
+  for (int b = 0; b < 4 * ecc_words; ++b) {
+    int w = b / 4, sh = 24 - 8 * (b % 4);
+    for (int e = 0; e < 16; ++e) {
+      encode_nib_tab[32 * b + e] =
+          (uint8_t)(encode_tab[e * ecc_words + w] >> sh);
+      encode_nib_tab[32 * b + 16 + e] =
+          (uint8_t)(encode_tab[(e << 4) * ecc_words + w] >> sh);
     }
   }
+}
+
+// --- Decoder tables ---
+void LiteBCHCode::init_decode_tables() const {
+  if (wide()) {
+    init_wide_decode_tables();
+    return;
+  }
+  alpha_8_pow.assign(2 * t + 1, 0);
+  for (int i = 1; i <= 2 * t; ++i)
+    alpha_8_pow[i] = (i * 8) % N;
 
   // --- Initialize Syndrome LUT for Fast Decoding ---
-  // syndrome_lut[i][b] = sum( bit_p * alpha^(i*p) ) for p=0..7
-  syndrome_lut.resize(2 * t + 1, std::vector<int>(256, 0));
-  for (int i = 1; i <= 2 * t; ++i) {
+  // syndrome_lut[(i / 2) * 256 + b] = sum( bit_p * alpha^(i*p) ) for p=0..7
+  // Only odd i: the even syndromes are squares (see even_syndromes).
+  syndrome_lut.assign(t * 256, 0);
+  for (int i = 1; i < 2 * t; i += 2) {
     for (int b = 0; b < 256; ++b) {
       int val = 0; // Poly form
       for (int p = 0; p < 8; ++p) {
@@ -266,139 +772,391 @@ void LiteBCH::init_fast_tables() {
           val ^= term;
         }
       }
-      syndrome_lut[i][b] = val;
+      syndrome_lut[(i / 2) * 256 + b] = (uint16_t)val;
     }
   }
-  // --- Initialize Syndrome LUT for Fast Decoding ---
-  // syndrome_lut[i][b] = sum( bit_p * alpha^(i*p) ) for p=0..7
-  syndrome_lut.resize(2 * t + 1, std::vector<int>(256, 0));
-  for (int i = 1; i <= 2 * t; ++i) {
-    for (int b = 0; b < 256; ++b) {
-      int val = 0; // Poly form
-      for (int p = 0; p < 8; ++p) {
-        if ((b >> p) & 1) {
-          // Term alpha^(i*p)
-          int term = alpha_to[(i * p) % N];
-          val ^= term;
-        }
-      }
-      syndrome_lut[i][b] = val;
+
+  // --- SIMD syndrome tables (odd syndromes only) ---
+  syndrome_tab.assign(t * sizeof(simd::SyndromeTable), 0);
+  for (int j = 0; j < t; ++j) {
+    int i = 2 * j + 1;
+    simd::SyndromeTable &tab = reinterpret_cast<simd::SyndromeTable *>(
+        syndrome_tab.data())[j];
+    build_mul_table(tab.step, (128 * i) % N, m, alpha_to.data(),
+                    index_of.data());
+    for (int e = 0; e < 16; ++e) {
+      const uint16_t *lut = &syndrome_lut[j * 256];
+      tab.in[0][e] = (uint8_t)lut[e];
+      tab.in[1][e] = (uint8_t)lut[e << 4];
+      tab.in[2][e] = (uint8_t)(lut[e] >> 8);
+      tab.in[3][e] = (uint8_t)(lut[e << 4] >> 8);
     }
   }
+
+  // --- Chien step tables ---
+  // One SIMD step moves every lane of term j forward by 16 positions.
+  chien_tab.assign(t * sizeof(simd::MulTable), 0);
+  for (int j = 1; j <= t; ++j)
+    build_mul_table(
+        reinterpret_cast<simd::MulTable *>(chien_tab.data())[j - 1],
+        (16 * j) % N, m, alpha_to.data(),
+                    index_of.data());
 }
 
-static void apply_mask(std::vector<uint32_t> &par, int n_bits) {
-  for (size_t w = 0; w < par.size(); ++w) {
-    int start_bit = w * 32;
-    if (start_bit >= n_bits) {
-      par[w] = 0;
-    } else {
-      int end_bit = start_bit + 32;
-      if (end_bit > n_bits) {
-        int valid_bits = n_bits - start_bit;
-        if (valid_bits < 32)
-          par[w] &= (1U << valid_bits) - 1;
-      }
+// --- Message Length ---
+// A len-byte message carries min(K, 8 * len) bits (see data_bits). Shorter
+// than K bits, it is a shortened codeword: the leading message bits are
+// implicitly zero, so they are neither stored nor processed.
+void LiteBCHCode::check_len(size_t len) const {
+  if (len > (size_t)(K + 7) / 8)
+    throw std::invalid_argument("Message length must be at most (K + 7) / 8 = " +
+                                std::to_string((K + 7) / 8) + " bytes");
+}
+
+// --- Byte-Oriented Encoding (Slice-by-4 LUT + Bitwise Tail) ---
+void LiteBCHCode::encode(const uint8_t *data, size_t len, uint8_t *ecc_out,
+                         Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  encode_core(data, len, ecc_out, ws);
+}
+
+void LiteBCHCode::encode_core(const uint8_t *data, size_t len,
+                              uint8_t *ecc_out, Workspace &ws) const {
+  need_encoder();
+  // State: 'par' (parity) stored as MSB-aligned 32-bit words
+  uint32_t *s = ws.par.data();
+  std::fill(s, s + ecc_words, 0);
+
+  // Leading zeros of a shortened message leave the remainder unchanged, so
+  // only the bits actually present are shifted in.
+  const int bits = data_bits(len);
+  shift_in_bytes(s, data, bits / 8, ws.wide.data());
+  if (bits % 8)
+    shift_in_bits(s, data[bits / 8], bits % 8);
+  store_ecc(s, ecc_out);
+}
+
+// Shifts n whole message bytes into the MSB-aligned remainder s. wide is
+// scratch for the carry-less encoder [clmul_words()].
+void LiteBCHCode::shift_in_bytes(uint32_t *s, const uint8_t *data, size_t n,
+                                 uint64_t *wide) const {
+  const int W = ecc_words;
+
+  // 0. Carry-less multiply encoder, 64 message bits per step. Its top-aligned
+  // 64-bit words are the pairs of the 32-bit ones, highest word last.
+  const simd::ClmulFn clmul = simd::active_clmul().encode;
+  if (clmul && n >= 16) {
+    const int cw = clmul_words();
+    for (int i = 0; i < cw; ++i)
+      wide[cw - 1 - i] = (uint64_t)s[2 * i] << 32 |
+                         (2 * i + 1 < W ? s[2 * i + 1] : 0);
+    simd::ClmulArgs args = {clmul_tab.data() + 3, clmul_tab.data(), cw};
+    clmul(args, wide, data, n / 8);
+    for (int i = 0; i < cw; ++i) {
+      s[2 * i] = (uint32_t)(wide[cw - 1 - i] >> 32);
+      if (2 * i + 1 < W)
+        s[2 * i + 1] = (uint32_t)wide[cw - 1 - i];
     }
+    data += n / 8 * 8;
+    n %= 8;
   }
-}
 
-// --- Byte-Oriented Encoding (Fast LUT + Bitwise Tail) ---
-void LiteBCH::encode(const uint8_t *data, size_t len, uint8_t *ecc_out) {
-  // State: 'par' (parity) stored as 32-bit words
-  std::vector<uint32_t> par(ecc_words, 0);
+  const uint32_t *tab0 = encode_tab.data();
+  const uint32_t *tab1 = tab0 + 256 * W;
+  const uint32_t *tab2 = tab1 + 256 * W;
+  const uint32_t *tab3 = tab2 + 256 * W;
+  size_t i = 0;
+
+  // 1. 32 message bits per step: the top remainder word is the feedback
+  for (; i + 4 <= n; i += 4) {
+    uint32_t feedback = s[0] ^ load_be32(data + i);
+    const uint32_t *p0 = tab0 + (feedback & 0xff) * W;
+    const uint32_t *p1 = tab1 + ((feedback >> 8) & 0xff) * W;
+    const uint32_t *p2 = tab2 + ((feedback >> 16) & 0xff) * W;
+    const uint32_t *p3 = tab3 + (feedback >> 24) * W;
+    for (int w = 0; w < W - 1; ++w)
+      s[w] = s[w + 1] ^ p0[w] ^ p1[w] ^ p2[w] ^ p3[w];
+    s[W - 1] = p0[W - 1] ^ p1[W - 1] ^ p2[W - 1] ^ p3[W - 1];
+  }
 
-  size_t full_bytes = K / 8;
-  int rem_bits = K % 8;
+  // 2. Leftover whole bytes
+  for (; i < n; ++i) {
+    uint8_t feedback = (uint8_t)(s[0] >> 24) ^ data[i];
+    shift_left_bits(s, W, 8);
+    const uint32_t *mask = tab0 + feedback * W;
+    for (int w = 0; w < W; ++w)
+      s[w] ^= mask[w];
+  }
+}
 
-  // 1. Fast LUT for full bytes
-  for (size_t i = 0; i < full_bytes; ++i) {
-    uint8_t input = data[i];
-    uint8_t feedback = get_top_byte(par, ecc_bits) ^ input;
-    shift_left_8(par, ecc_words);
-    apply_mask(par, ecc_bits);
+// Shifts in the top 'bits' (1..7) bits of b, the partial last byte of a
+// full-length message. Slice 0 also covers a short feedback value:
+// F(x) * x^ecc_bits mod g.
+void LiteBCHCode::shift_in_bits(uint32_t *s, uint8_t b, int bits) const {
+  const int W = ecc_words;
+  uint8_t feedback = (uint8_t)((s[0] >> (32 - bits)) ^ (b >> (8 - bits)));
+  shift_left_bits(s, W, bits);
+  const uint32_t *mask = encode_tab.data() + feedback * W;
+  for (int w = 0; w < W; ++w)
+    s[w] ^= mask[w];
+}
 
-    const auto &mask = encode_lut[feedback];
-    for (int w = 0; w < ecc_words; ++w) {
-      par[w] ^= mask[w];
-    }
-  }
-
-  // 2. Bitwise processing for remaining bits (if any)
-  if (rem_bits > 0) {
-    uint8_t last_byte = data[full_bytes];
-    // Bits are packed MSB first (7..0).
-    // We only process rem_bits from the top (7 downto 8-rem_bits).
-    for (int b = 0; b < rem_bits; ++b) {
-      int bit_pos = 7 - b;
-      int input_bit = (last_byte >> bit_pos) & 1;
-
-      // LFSR Step (1 bit)
-      // Extract top bit of par
-      int top_bit = 0;
-      int word_idx = (ecc_bits - 1) / 32;
-      int bit_idx = (ecc_bits - 1) % 32;
-      if (par[word_idx] & (1U << bit_idx))
-        top_bit = 1;
-
-      int feedback = input_bit ^ top_bit;
-
-      // Shift Left 1
-      uint32_t carry = 0;
-      for (int w = 0; w < ecc_words; ++w) {
-        uint32_t temp = par[w];
-        par[w] = (temp << 1) | carry;
-        carry = (temp >> 31);
-      }
+// Output result: ecc bit i holds coefficient x^i (LSB packed)
+void LiteBCHCode::store_ecc(const uint32_t *s, uint8_t *ecc_out) const {
+  const int W = ecc_words;
+  int pad = 32 * W - ecc_bits;
+  for (int b = 0; b < ecc_bytes; ++b) {
+    int bit = pad + 8 * b; // offset from the LSB of the last word
+    int w = W - 1 - bit / 32;
+    int sh = bit % 32;
+    uint32_t v = s[w] >> sh;
+    if (sh > 24 && w > 0)
+      v |= s[w - 1] << (32 - sh);
+    ecc_out[b] = (uint8_t)v;
+  }
+}
 
-      // Add g if feedback
-      if (feedback) {
-        for (int k = 0; k < ecc_bits; ++k) {
-          if (g[k]) { // g is binary
-            int w = k / 32;
-            int b = k % 32;
-            par[w] ^= (1U << b);
-          }
-        }
+// --- Lockstep Batch Encoding ---
+// One codeword per vector byte lane: the lanes feed their message bytes
+// through the same table shuffles, which breaks the byte-to-byte dependency
+// of a single LFSR. The kernel runs whole 16-byte blocks; the rest of the
+// message goes through the scalar path per lane.
+void LiteBCHCode::encode_lanes(const uint8_t *data, size_t len, size_t stride,
+                               uint8_t *ecc, size_t ecc_stride,
+                               Workspace &ws) const {
+  need_lanes();
+  const simd::Kernels &kern = simd::active_kernels();
+  const int lanes = kern.lanes;
+  const int R = 4 * ecc_words;
+  const int bits = data_bits(len);
+  const size_t done = (size_t)(bits / 8) / 16 * 16;
+
+  uint8_t *planes = ws.enc_planes.data();
+  std::fill(planes, planes + R * lanes, 0);
+  simd::EncodeArgs args = {data,   stride, done / 16,
+                           reinterpret_cast<const uint8_t(*)[32]>(
+                               encode_nib_tab.data()),
+                           planes, R,      0};
+  int head = kern.encode(args);
+
+  uint32_t *s = ws.par.data();
+  for (int k = 0; k < lanes; ++k) {
+    for (int w = 0; w < ecc_words; ++w) {
+      uint32_t v = 0;
+      for (int j = 0; j < 4; ++j) {
+        int q = (head + 4 * w + j) % R;
+        v = (v << 8) | planes[q * lanes + k];
       }
+      s[w] = v;
     }
-    // Final mask
-    apply_mask(par, ecc_bits);
+    const uint8_t *msg = data + k * stride;
+    shift_in_bytes(s, msg + done, bits / 8 - done, ws.wide.data());
+    if (bits % 8)
+      shift_in_bits(s, msg[bits / 8], bits % 8);
+    store_ecc(s, ecc + k * ecc_stride);
   }
+}
 
-  // Output result
-  std::memset(ecc_out, 0, ecc_bytes);
-  for (int i = 0; i < ecc_bits; ++i) {
-    int w = i / 32;
-    int b = i % 32;
-    if (par[w] & (1 << b)) {
-      ecc_out[i / 8] |= (1 << (i % 8));
+// --- Streaming Encoding ---
+// The state is the remainder of the bytes fed so far. Feeding more bytes
+// continues the same LFSR, so any split of the message gives the ECC of
+// the whole. Byte K / 8 can only be the partial last byte of a full-length
+// message and contributes its top K % 8 bits.
+
+LiteBCHCode::EncodeState LiteBCHCode::encode_begin() const {
+  EncodeState st;
+  encode_begin(st);
+  return st;
+}
+
+void LiteBCHCode::encode_begin(EncodeState &st) const {
+  st.code = this;
+  st.rem.assign(ecc_words, 0);
+  st.wide.resize(clmul_words());
+  st.bytes = 0;
+}
+
+void LiteBCHCode::encode_update(EncodeState &st, const uint8_t *data,
+                                size_t n) const {
+  if (st.code != this)
+    throw std::invalid_argument("EncodeState was not started by this code");
+  const size_t max_bytes = (K + 7) / 8;
+  if (n > max_bytes - st.bytes)
+    throw std::invalid_argument("Message length must be at most (K + 7) / 8 = " +
+                                std::to_string(max_bytes) + " bytes");
+  need_encoder();
+  const size_t whole = K / 8;
+  size_t take = st.bytes < whole ? std::min(n, whole - st.bytes) : 0;
+  shift_in_bytes(st.rem.data(), data, take, st.wide.data());
+  if (take < n) // n - take == 1
+    shift_in_bits(st.rem.data(), data[take], K % 8);
+  st.bytes += n;
+}
+
+void LiteBCHCode::encode_final(const EncodeState &st, uint8_t *ecc_out) const {
+  if (st.code != this)
+    throw std::invalid_argument("EncodeState was not started by this code");
+  store_ecc(st.rem.data(), ecc_out);
+}
+
+// --- Parity Update ---
+// ECC(new) = ECC(old) ^ ECC(delta), and with z message bits after the
+// changed field, ECC(delta) = rem(delta) * x^z mod g, where rem(delta) is
+// the remainder of the delta bytes encoded on their own. Multiplying by x^z
+// takes z % 8 single-bit steps, then zero-byte steps for the low bits of
+// z / 8 and one table product per remaining set bit.
+
+// Multiplies the MSB-aligned remainder s by x^8 mod g (one zero input byte).
+static inline void times_x8(uint32_t *s, int words, const uint32_t *tab0) {
+  uint8_t feedback = (uint8_t)(s[0] >> 24);
+  shift_left_bits(s, words, 8);
+  const uint32_t *mask = tab0 + feedback * words;
+  for (int w = 0; w < words; ++w)
+    s[w] ^= mask[w];
+}
+
+void LiteBCHCode::init_shift_tables() const {
+  need_encoder();
+  const int W = ecc_words;
+
+  // Levels below 2^shift_base bytes are cheaper as zero-byte steps than as
+  // a table product (ecc_bytes steps).
+  shift_base = 0;
+  while ((1 << shift_base) < 2 * ecc_bytes)
+    ++shift_base;
+  int levels = 0;
+  while (((size_t)1 << (shift_base + levels)) <= (size_t)K / 8)
+    ++levels;
+  shift_tab.assign((size_t)levels * 256 * W, 0);
+  if (!levels)
+    return;
+
+  // x^(8 2^shift_base) mod g, from 1 (coefficient x^0, bit ecc_bits - 1)
+  std::vector<uint32_t> c(W, 0);
+  c[(ecc_bits - 1) / 32] = 1U << (31 - (ecc_bits - 1) % 32);
+  for (int i = 0; i < (1 << shift_base); ++i)
+    times_x8(c.data(), W, encode_tab.data());
+
+  std::vector<uint8_t> digits(ecc_bytes);
+  for (int L = 0; L < levels; ++L) {
+    // Row b = b(x) * c: entry 2^j is c * x^j, the others are XORs of those
+    uint32_t *tab = &shift_tab[(size_t)L * 256 * W];
+    std::vector<uint32_t> bit = c;
+    for (int j = 0; j < 8; ++j) {
+      for (int b = 1 << j; b < (2 << j); ++b)
+        for (int w = 0; w < W; ++w)
+          tab[b * W + w] = tab[(b ^ (1 << j)) * W + w] ^ bit[w];
+      shift_in_bits(bit.data(), 0, 1);
     }
+    mul_shift(c.data(), tab, digits.data()); // c^2 for the next level
   }
 }
 
-std::vector<LiteBCH::B> LiteBCH::encode(const std::vector<B> &message_bits) {
-  if (message_bits.size() != (size_t)K) {
-    throw std::invalid_argument("Message size must be K=" + std::to_string(K));
+// s = s * c mod g for the table of c (a shift_tab level): Horner over the
+// bytes of s, highest coefficients first. digits is scratch [ecc_bytes].
+void LiteBCHCode::mul_shift(uint32_t *s, const uint32_t *tab,
+                            uint8_t *digits) const {
+  const int W = ecc_words;
+  store_ecc(s, digits); // digits[b] = coefficients x^(8b) .. x^(8b + 7)
+  std::fill(s, s + W, 0);
+  for (int b = ecc_bytes - 1; b >= 0; --b) {
+    // s = s * x^8 + digit * c, one pass
+    const uint32_t *mask = encode_tab.data() + (s[0] >> 24) * W;
+    const uint32_t *row = tab + digits[b] * W;
+    for (int w = 0; w < W - 1; ++w)
+      s[w] = (s[w] << 8 | s[w + 1] >> 24) ^ mask[w] ^ row[w];
+    s[W - 1] = s[W - 1] << 8 ^ mask[W - 1] ^ row[W - 1];
   }
-  std::vector<B> encoded(N);
-  // Construct systematic form: [Parity | Message]
-  // This layout matches aff3ct conventions.
+}
 
-  std::vector<B> par(n_rdncy);
-  __encode(message_bits.data(), par.data());
+// s = s * x^(8q) mod g, q <= K / 8. The carry-less encoder runs zero bytes
+// fast enough to also take the low levels, up to about 32 ecc_bytes.
+void LiteBCHCode::shift_zero_bytes(uint32_t *s, size_t q, uint8_t *digits,
+                                   uint64_t *wide) const {
+  int base = shift_base;
+  if (simd::active_clmul().encode)
+    while (((size_t)1 << base) < (size_t)32 * ecc_bytes)
+      ++base;
+  size_t low = q & (((size_t)1 << base) - 1);
+  static const uint8_t zeros[256] = {};
+  for (; low >= 16; low -= std::min(low, sizeof(zeros)))
+    shift_in_bytes(s, zeros, std::min(low, sizeof(zeros)), wide);
+  for (; low; --low)
+    times_x8(s, ecc_words, encode_tab.data());
+  q >>= base;
+  for (int L = base - shift_base; q; ++L, q >>= 1)
+    if (q & 1)
+      mul_shift(s, &shift_tab[(size_t)L * 256 * ecc_words], digits);
+}
 
-  // Copy parity to start
-  for (int i = 0; i < n_rdncy; ++i)
-    encoded[i] = par[i];
-  // Copy message to end
-  for (int i = 0; i < K; ++i)
-    encoded[n_rdncy + i] = message_bits[i];
+void LiteBCHCode::update_ecc(uint8_t *ecc, size_t len, size_t offset,
+                             const uint8_t *old_bytes,
+                             const uint8_t *new_bytes, size_t n,
+                             Workspace &ws) const {
+  check_len(len);
+  if (offset > len || n > len - offset)
+    throw std::invalid_argument("Field [offset, offset + n) must lie within "
+                                "the len-byte message");
+  if (!n)
+    return;
+  ws.prepare(*this);
+  need_shift();
+
+  // Message bits [begin, end) change; a field ending in the partial last
+  // byte of a full-length message covers only its top K % 8 bits.
+  const size_t bits = (size_t)data_bits(len);
+  const size_t end = std::min(8 * (offset + n), bits);
+  const size_t whole = (end - 8 * offset) / 8;
+
+  uint32_t *s = ws.par.data();
+  std::fill(s, s + ecc_words, 0);
+  uint8_t delta[256];
+  for (size_t i = 0; i < whole; i += sizeof(delta)) {
+    const size_t c = std::min(whole - i, sizeof(delta));
+    for (size_t k = 0; k < c; ++k)
+      delta[k] = old_bytes[i + k] ^ new_bytes[i + k];
+    shift_in_bytes(s, delta, c, ws.wide.data());
+  }
+  if (whole < n)
+    shift_in_bits(s, old_bytes[whole] ^ new_bytes[whole], (int)(end % 8));
+
+  const size_t z = bits - end;
+  if (z % 8)
+    shift_in_bits(s, 0, (int)(z % 8));
+  uint8_t *delta_ecc = ws.calc_ecc.data();
+  shift_zero_bytes(s, z / 8, delta_ecc, ws.wide.data());
+  store_ecc(s, delta_ecc);
+  for (int b = 0; b < ecc_bytes; ++b)
+    ecc[b] ^= delta_ecc[b];
+}
 
+std::vector<LiteBCHCode::B>
+LiteBCHCode::encode(const std::vector<B> &message_bits,
+                    ReferenceMode mode) const {
+  Workspace ws(*this);
+  return encode(message_bits, ws, mode);
+}
+
+std::vector<LiteBCHCode::B>
+LiteBCHCode::encode(const std::vector<B> &message_bits, Workspace &ws,
+                    ReferenceMode mode) const {
+  if (message_bits.size() != (size_t)K) {
+    throw std::invalid_argument("Message size must be K=" + std::to_string(K));
+  }
+  // Systematic form [Parity | Message], the aff3ct layout
+  std::vector<B> encoded(N);
+  if (mode == ReferenceMode::Off) {
+    encode_bits(message_bits.data(), encoded.data(), ws);
+    return encoded;
+  }
+  __encode(message_bits.data(), encoded.data());
+  std::copy(message_bits.begin(), message_bits.end(),
+            encoded.begin() + n_rdncy);
   return encoded;
 }
 
-void LiteBCH::__encode(const B *U_K, B *par) {
+void LiteBCHCode::__encode(const B *U_K, B *par) const {
   std::fill(par, par + n_rdncy, (B)0);
   for (auto i = K - 1; i >= 0; i--) {
     const auto feedback = U_K[i] ^ par[n_rdncy - 1];
@@ -412,53 +1170,186 @@ void LiteBCH::__encode(const B *U_K, B *par) {
 // Decoding Logic (from Decoder_BCH_std)
 // ==========================================
 
-bool LiteBCH::decode(const std::vector<B> &received_bits,
-                     std::vector<B> &decoded_message) {
+bool LiteBCHCode::decode(const std::vector<B> &received_bits,
+                         std::vector<B> &decoded_message, Workspace &ws,
+                         ReferenceMode mode) const {
   if (received_bits.size() != (size_t)N)
     return false;
+  decoded_message.resize(K);
+  if (mode == ReferenceMode::Off)
+    return decode_bits(received_bits.data(), decoded_message.data(), ws) >= 0;
+
+  std::vector<B> codeword(received_bits); // _decode corrects in place
+  bool ok = _decode(codeword.data(), ws) == 0;
+  std::copy(codeword.begin() + n_rdncy, codeword.end(),
+            decoded_message.begin());
+  return ok;
+}
 
-  // Pack Bits to Bytes for Fast Decode
-  // Layout: [Parity (n_rdncy) | Message (K)]
-  int n_data_bytes = (K + 7) / 8;
-  int n_ecc_bytes = ecc_bytes;
-  std::vector<uint8_t> data(n_data_bytes, 0);
-  std::vector<uint8_t> ecc(n_ecc_bytes, 0);
+// --- Bit-Per-Element API ---
+// Message bit i is at stream position K - 1 - i, so the data bytes read as
+// a big-endian number are sum U_K[i] * 2^(i + pad), pad = 8 * len - K: the
+// LSB-first packing of U_K moved up by pad bits, in reverse byte order. The
+// lowest byte takes the first 8 - pad bits; the rest is byte-aligned.
 
-  // Pack Parity -> ECC (LSB packed)
-  for (int i = 0; i < n_rdncy; ++i) {
-    if (received_bits[i])
-      ecc[i / 8] |= (1 << (i % 8));
-  }
+static_assert(sizeof(LiteBCHCode::B) == sizeof(int32_t),
+              "bit kernels take int32_t elements");
 
-  // Pack Message -> Data (MSB packed, High Degree First)
-  // Message indices 0..K-1. Index K-1 is High Degree.
-  // We want High Degree at Stream Pos 0.
-  for (int i = 0; i < K; ++i) {
-    if (received_bits[n_rdncy + i]) {
-      int stream_pos = K - 1 - i;
-      data[stream_pos / 8] |= (1 << (7 - (stream_pos % 8)));
-    }
-  }
+namespace {
 
-  // Fast Decode
-  int count = decode(data.data(), n_data_bytes, ecc.data());
+void pack(const LiteBCHCode::B *in, size_t n, uint8_t *out) {
+  const simd::Kernels &kern = simd::active_kernels();
+  const int32_t *p = reinterpret_cast<const int32_t *>(in);
+  if (kern.pack)
+    kern.pack(p, n, out);
+  else
+    simd::pack_bits(p, n, out);
+}
 
-  if (count < 0)
-    return false;
+void pack(const uint8_t *in, size_t n, uint8_t *out) {
+  const simd::Kernels &kern = simd::active_kernels();
+  if (kern.pack8)
+    kern.pack8(in, n, out);
+  else
+    simd::pack_bits(in, n, out);
+}
 
-  // Unpack Corrected Data
-  decoded_message.resize(K);
-  for (int i = 0; i < K; ++i) {
-    int stream_pos = K - 1 - i;
-    int byte_idx = stream_pos / 8;
-    int bit_idx = 7 - (stream_pos % 8);
-    decoded_message[i] = (data[byte_idx] >> bit_idx) & 1;
-  }
+void unpack(const uint8_t *in, size_t n, LiteBCHCode::B *out) {
+  const simd::Kernels &kern = simd::active_kernels();
+  int32_t *p = reinterpret_cast<int32_t *>(out);
+  if (kern.unpack)
+    kern.unpack(in, n, p);
+  else
+    simd::unpack_bits(in, n, p);
+}
 
-  return true;
+void unpack(const uint8_t *in, size_t n, uint8_t *out) {
+  const simd::Kernels &kern = simd::active_kernels();
+  if (kern.unpack8)
+    kern.unpack8(in, n, out);
+  else
+    simd::unpack_bits(in, n, out);
+}
+
+} // namespace
+
+template <class T>
+void LiteBCHCode::pack_message(const T *U_K, uint8_t *data) const {
+  const size_t len = (K + 7) / 8;
+  const int pad = (int)(8 * len) - K;
+  uint8_t low = 0;
+  for (int i = 0; i < 8 - pad; ++i)
+    low |= (uint8_t)((U_K[i] != 0) << (i + pad));
+  data[0] = low;
+  pack(U_K + 8 - pad, 8 * (len - 1), data + 1);
+  std::reverse(data, data + len);
+}
+
+template <class T>
+void LiteBCHCode::unpack_message(uint8_t *data, T *V_K) const {
+  const size_t len = (K + 7) / 8;
+  const int pad = (int)(8 * len) - K;
+  std::reverse(data, data + len);
+  for (int i = 0; i < 8 - pad; ++i)
+    V_K[i] = (T)((data[0] >> (i + pad)) & 1);
+  unpack(data + 1, 8 * (len - 1), V_K + 8 - pad);
+}
+
+template <class T>
+void LiteBCHCode::encode_bits_core(const T *U_K, T *X_N, Workspace &ws) const {
+  ws.prepare(*this);
+  const size_t len = (K + 7) / 8;
+  if (ws.bits.size() < len + ecc_bytes)
+    ws.bits.resize(len + ecc_bytes);
+  uint8_t *data = ws.bits.data();
+  uint8_t *ecc = data + len;
+  pack_message(U_K, data);
+  encode_core(data, len, ecc, ws);
+
+  if (X_N + n_rdncy != U_K)
+    std::memmove(X_N + n_rdncy, U_K, K * sizeof(T));
+  unpack(ecc, n_rdncy, X_N);
+}
+
+template <class T>
+int LiteBCHCode::decode_bits_core(const T *Y_N, T *V_K, Workspace &ws) const {
+  ws.prepare(*this);
+  const size_t len = (K + 7) / 8;
+  if (ws.bits.size() < len + ecc_bytes)
+    ws.bits.resize(len + ecc_bytes);
+  uint8_t *data = ws.bits.data();
+  uint8_t *ecc = data + len;
+  pack(Y_N, n_rdncy, ecc);
+  pack_message(Y_N + n_rdncy, data);
+
+  int count = decode_core(data, len, ecc, ws);
+  unpack_message(data, V_K); // unchanged if uncorrectable
+  return count;
+}
+
+// Hard decisions of the LLRs (negative = 1) go through the byte layout of
+// decode_bits_core.
+template <class T>
+int LiteBCHCode::chase_bits_core(const float *Y_N, T *V_K, int p,
+                                 Workspace &ws) const {
+  if (p < 0 || p > max_chase_positions)
+    throw std::invalid_argument("Chase positions must be in [0, 16]");
+  ws.prepare(*this);
+  const size_t len = (K + 7) / 8;
+  if (ws.bits.size() < len + ecc_bytes)
+    ws.bits.resize(len + ecc_bytes);
+  if (ws.chase_hard.size() < (size_t)N)
+    ws.chase_hard.resize(N);
+  uint8_t *hard = ws.chase_hard.data();
+  for (int j = 0; j < N; ++j)
+    hard[j] = Y_N[j] < 0;
+  uint8_t *data = ws.bits.data();
+  uint8_t *ecc = data + len;
+  pack(hard, n_rdncy, ecc);
+  pack_message(hard + n_rdncy, data);
+
+  int count = chase_core(data, len, ecc, Y_N, p, ws);
+  unpack_message(data, V_K); // the hard decision if no pattern decodes
+  return count;
+}
+
+int LiteBCHCode::decode_chase_bits(const float *Y_N, B *V_K, int p,
+                                   Workspace &ws) const {
+  return chase_bits_core(Y_N, V_K, p, ws);
 }
 
-int LiteBCH::_decode(B *Y_N) {
+int LiteBCHCode::decode_chase_bits(const float *Y_N, uint8_t *V_K, int p,
+                                   Workspace &ws) const {
+  return chase_bits_core(Y_N, V_K, p, ws);
+}
+
+void LiteBCHCode::encode_bits(const B *U_K, B *X_N, Workspace &ws) const {
+  encode_bits_core(U_K, X_N, ws);
+}
+
+void LiteBCHCode::encode_bits(const uint8_t *U_K, uint8_t *X_N,
+                              Workspace &ws) const {
+  encode_bits_core(U_K, X_N, ws);
+}
+
+int LiteBCHCode::decode_bits(const B *Y_N, B *V_K, Workspace &ws) const {
+  return decode_bits_core(Y_N, V_K, ws);
+}
+
+int LiteBCHCode::decode_bits(const uint8_t *Y_N, uint8_t *V_K,
+                             Workspace &ws) const {
+  return decode_bits_core(Y_N, V_K, ws);
+}
+
+int LiteBCHCode::_decode(B *Y_N, Workspace &ws) const {
+  if (wide())
+    throw std::invalid_argument(
+        "ReferenceMode::BitSerial decoding needs m <= 16");
+  ws.prepare(*this);
+  auto &s = ws.s;
+  auto &loc = ws.loc;
+  auto &reg = ws.reg;
+
   int i, j, syn_error = 0;
   int t2 = 2 * t;
   int N_p2_1 = N; // Assuming N is 2^m - 1
@@ -471,307 +1362,1124 @@ int LiteBCH::_decode(B *Y_N) {
         s[i] ^= alpha_to[(i * j) % N_p2_1];
     if (s[i] != 0)
       syn_error = 1;
-    s[i] = (int)index_of[s[i]];
+    s[i] = gf_log(s[i]);
   }
 
   if (!syn_error)
     return 0; // Success
 
-  /* Berlekamp iterative algorithm */
-  discrepancy[0] = 0;
-  discrepancy[1] = s[1];
-  elp[0][0] = 0;
-  elp[1][0] = 1;
-  for (i = 1; i < t2; i++) {
-    elp[0][i] = -1;
-    elp[1][i] = 0;
-  }
-  l[0] = 0;
-  l[1] = 0;
-  u_lu[0] = -1;
-  u_lu[1] = 0;
-
-  int q, u = 0;
-  do {
-    u++;
-    if (discrepancy[u] == -1) {
-      l[u + 1] = l[u];
-      for (i = 0; i <= l[u]; i++) {
-        elp[u + 1][i] = elp[u][i];
-        elp[u][i] = (int)index_of[elp[u][i]];
-      }
-    } else {
-      q = u - 1;
-      while ((discrepancy[q] == -1) && (q > 0))
-        q--;
-      if (q > 0) {
-        j = q;
-        do {
-          j--;
-          if ((discrepancy[j] != -1) && (u_lu[q] < u_lu[j]))
-            q = j;
-        } while (j > 0);
+  /* Berlekamp iterative algorithm (shared with decode) */
+  int deg = berlekamp_massey(ws);
+  if (deg < 0)
+    return 1; // Failure
+  const auto &elp = ws.lambda;
+
+  // Chien search
+  for (i = 1; i <= deg; i++)
+    reg[i] = elp[i];
+  int count = 0;
+  for (i = 1; i <= N_p2_1; i++) {
+    int q = 1;
+    for (j = 1; j <= deg; j++)
+      if (reg[j] != -1) {
+        reg[j] = (reg[j] + j) % N_p2_1;
+        q ^= alpha_to[reg[j]];
       }
+    if (!q) {
+      loc[count++] = N_p2_1 - i;
+    }
+  }
+
+  if (count != deg)
+    return 1; // Failure
+  for (i = 0; i < deg; i++)
+    if (loc[i] < N)
+      Y_N[loc[i]] ^= 1;
+  return 0; // Success
+}
 
-      if (l[u] > l[q] + u - q)
-        l[u + 1] = l[u];
-      else
-        l[u + 1] = l[q] + u - q;
-
-      for (i = 0; i < t2; i++)
-        elp[u + 1][i] = 0;
-      for (i = 0; i <= l[q]; i++)
-        if (elp[q][i] != -1)
-          elp[u + 1][i + u - q] = (int)
-              alpha_to[(discrepancy[u] + N_p2_1 - discrepancy[q] + elp[q][i]) %
-                       N_p2_1];
-      for (i = 0; i <= l[u]; i++) {
-        elp[u + 1][i] ^= elp[u][i];
-        elp[u][i] = (int)index_of[elp[u][i]];
+// ==========================================
+// Syndromes
+// ==========================================
+// s[i] = P(alpha^i) for odd i in [1, 2t], where P is the byte polynomial
+// p[0..n): p[0] holds the highest 8 coefficients and bit j of a byte is the
+// coefficient of x^j within it. The bulk runs on the SIMD kernel with one
+// interleaved stream per lane; the rest uses the byte LUT.
+void LiteBCHCode::odd_syndromes(const uint8_t *p, size_t n, int *s) const {
+  const simd::Kernels &kern = simd::active_kernels();
+  const int lanes = kern.lanes;
+  const int groups = lanes / 16;
+  const size_t blocks = groups ? n / (16 * groups) : 0;
+  size_t done = 0;
+
+  if (kern.syndrome && blocks >= 2) {
+    const size_t seg = 16 * blocks;
+    done = groups * seg;
+    const simd::SyndromeTable *tabs =
+        reinterpret_cast<const simd::SyndromeTable *>(syndrome_tab.data());
+    uint8_t lo[64], hi[64];
+    for (int i = 1; i < 2 * t; i += 2) {
+      simd::SyndromeArgs args = {p, seg, blocks, &tabs[i / 2], m > 8};
+      kern.syndrome(args, lo, hi);
+      // Lane (g, k) ends at byte g * seg + seg - 16 + k. The bulk ends at
+      // byte done - 1, so the lane is shifted by 8 * (done - 1 - last); the
+      // tail Horner below shifts everything by the remaining bytes.
+      int v = 0;
+      for (int lane = 0; lane < lanes; ++lane) {
+        int x = lo[lane] | (hi[lane] << 8);
+        if (!x)
+          continue;
+        size_t last = (lane / 16) * seg + seg - 16 + lane % 16;
+        int64_t e = (int64_t)(8 * (done - 1 - last) % N) * i % N;
+        v ^= alpha_to[index_of[x] + e];
       }
+      s[i] = v;
     }
-    u_lu[u + 1] = u - l[u + 1];
-
-    if (u < t2) {
-      if (s[u + 1] != -1)
-        discrepancy[u + 1] = (int)alpha_to[s[u + 1]];
-      else
-        discrepancy[u + 1] = 0;
+  } else {
+    for (int i = 1; i < 2 * t; i += 2)
+      s[i] = 0;
+  }
 
-      for (i = 1; i <= l[u + 1]; i++)
-        if ((s[u + 1 - i] != -1) && (elp[u + 1][i] != 0))
-          discrepancy[u + 1] ^=
-              alpha_to[(s[u + 1 - i] + index_of[elp[u + 1][i]]) % N_p2_1];
-      discrepancy[u + 1] = (int)index_of[discrepancy[u + 1]];
+  for (size_t q = done; q < n; ++q) {
+    uint8_t b = p[q];
+    for (int i = 1; i < 2 * t; i += 2) {
+      int v = s[i];
+      if (v)
+        v = alpha_to[index_of[v] + alpha_8_pow[i]];
+      s[i] = v ^ syndrome_lut[(i / 2) * 256 + b];
     }
-  } while ((u < t2) && (l[u + 1] <= t));
+  }
+}
 
-  u++;
-  if (l[u] <= t) {
-    for (i = 0; i <= l[u]; i++)
-      elp[u][i] = (int)index_of[elp[u][i]];
+// Binary code: S_2i = P(alpha^2i) = P(alpha^i)^2.
+void LiteBCHCode::even_syndromes(int *s) const {
+  for (int i = 2; i <= 2 * t; i += 2)
+    s[i] = s[i / 2] ? alpha_to[2 * index_of[s[i / 2]]] : 0;
+}
 
-    // Chien search
-    for (i = 1; i <= l[u]; i++)
-      reg[i] = elp[u][i];
-    int count = 0;
-    for (i = 1; i <= N_p2_1; i++) {
-      q = 1;
-      for (j = 1; j <= l[u]; j++)
-        if (reg[j] != -1) {
-          reg[j] = (reg[j] + j) % N_p2_1;
-          q ^= alpha_to[reg[j]];
+bool LiteBCHCode::syndromes(const uint8_t *data, size_t len, const uint8_t *ecc,
+                            int *s, Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  need_decoder();
+  const int t2 = 2 * t;
+
+  // Wide fields: the syndromes of the re-encoded remainder, as in decode(),
+  // which equal those of the codeword.
+  if (wide()) {
+    bool error = remainder_syndromes(data, len, ecc, ws);
+    for (int i = 1; i <= t2; ++i)
+      s[i] = error ? ws.s[i] : 0;
+    return error;
+  }
+
+  // Data: data_bits(len) bits, MSB-first. Evaluate all bytes but the last in
+  // bulk, then the last one with its padding bits cleared. The result is
+  // D(x) * x^pad.
+  const int bits = data_bits(len);
+  const size_t n = (bits + 7) / 8;
+  const int pad = (int)(8 * n) - bits;
+  if (n == 0) {
+    for (int i = 1; i < t2; i += 2)
+      s[i] = 0;
+  } else {
+    odd_syndromes(data, n - 1, s);
+  }
+  uint8_t last = n ? data[n - 1] & (uint8_t)(0xff << pad) : 0;
+  for (int i = 1; i < t2; i += 2) {
+    int v = s[i];
+    if (v)
+      v = alpha_to[index_of[v] + alpha_8_pow[i]];
+    v ^= syndrome_lut[(i / 2) * 256 + last];
+    // Codeword = D(x) * x^r + E(x)
+    if (v)
+      v = alpha_to[index_of[v] + (int)((int64_t)i * (n_rdncy - pad + N) % N)];
+    s[i] = v;
+  }
+
+  // ECC: LSB-packed, highest byte last
+  uint8_t *rev = ws.calc_ecc.data();
+  for (int k = 0; k < ecc_bytes; ++k)
+    rev[k] = ecc[ecc_bytes - 1 - k];
+  if (ecc_bits % 8)
+    rev[0] &= (1 << (ecc_bits % 8)) - 1;
+  int *e = ws.s.data();
+  odd_syndromes(rev, ecc_bytes, e);
+
+  bool error = false;
+  for (int i = 1; i < t2; i += 2) {
+    s[i] ^= e[i];
+    error |= s[i] != 0;
+  }
+  even_syndromes(s);
+  return error;
+}
+
+// ==========================================
+// Chien Search
+// ==========================================
+// Finds the roots of the locator polynomial elp (index form, degree deg)
+// among the n_bits lowest codeword degrees. Lambda(alpha^i) == 0 marks an
+// error at degree N - i, so only i in [N - n_bits + 1, N] is searched.
+// Stops as soon as deg roots are found; returns the number of roots stored
+// in loc (degrees).
+int LiteBCHCode::chien_search(const int *elp, int deg, int n_bits, int *loc,
+                              Workspace &ws) const {
+  const int first = N - n_bits + 1;
+  int count = 0;
+
+  const simd::Kernels &kern = simd::active_kernels();
+  if (kern.chien && n_bits >= 4 * kern.lanes) {
+    // Lanes form groups of 16 consecutive positions. Group g covers 'span'
+    // positions from first + g * span; a step advances all groups by 16.
+    const int lanes = kern.lanes;
+    const int steps = (n_bits + lanes - 1) / lanes;
+    const int span = steps * 16;
+    for (int j = 1; j <= deg; ++j) {
+      uint8_t *lo = &ws.chien_lo[(j - 1) * lanes];
+      uint8_t *hi = &ws.chien_hi[(j - 1) * lanes];
+      for (int lane = 0; lane < lanes; ++lane) {
+        int v = 0;
+        if (elp[j] != -1) {
+          int64_t i = first + (lane / 16) * span + lane % 16;
+          v = alpha_to[(elp[j] + j * i) % N];
         }
-      if (!q) {
-        loc[count++] = N_p2_1 - i;
+        lo[lane] = (uint8_t)v;
+        hi[lane] = (uint8_t)(v >> 8);
+      }
+    }
+
+    simd::ChienArgs args = {
+        ws.chien_lo.data(), ws.chien_hi.data(),
+        reinterpret_cast<const simd::MulTable *>(chien_tab.data()), deg,
+        m > 8};
+    int step = 0;
+    while (step < steps) {
+      uint64_t mask;
+      step += kern.chien(args, steps - step, &mask);
+      for (int lane = 0; mask; ++lane, mask >>= 1) {
+        if (!(mask & 1))
+          continue;
+        int i = first + (lane / 16) * span + (step - 1) * 16 + lane % 16;
+        if (i > N)
+          continue; // Tail of the last group
+        loc[count++] = N - i;
+        if (count == deg)
+          return count;
       }
     }
+    return count;
+  }
+
+  // Scalar: reg[j] = log of term j at the current position.
+  int *reg = ws.reg.data();
+  for (int j = 1; j <= deg; j++)
+    reg[j] = (elp[j] == -1) ? -1
+                            : (int)((elp[j] + (int64_t)j * (first - 1)) % N);
+  for (int i = first; i <= N; i++) {
+    int q = 1;
+    for (int j = 1; j <= deg; j++)
+      if (reg[j] != -1) {
+        int val = reg[j] + j;
+        if (val >= N)
+          val -= N;
+        reg[j] = val;
+        q ^= alpha_to[val];
+      }
+    if (!q) {
+      loc[count++] = N - i;
+      if (count == deg)
+        break;
+    }
+  }
+  return count;
+}
+
+// ==========================================
+// Low-Degree Root Finding
+// ==========================================
+// Locator polynomials of degree <= 4 are solved directly. Their roots are
+// those of sigma(z) = z^deg * Lambda(1/z) = z^deg + l1 z^(deg-1) + ... + ldeg,
+// and a root z = alpha^d marks an error at degree d. Degrees 2..4 are turned
+// into an affine polynomial c2 z^4 + c1 z^2 + c0 z = rhs, whose left side is
+// linear over GF(2), so it is solved with Gaussian elimination on an m x m
+// bit matrix. Every candidate is checked against sigma.
+
+// Writes all solutions of c0 z + c1 z^2 + c2 z^4 = rhs to out and returns
+// their number, or -1 if there are more than 4.
+int LiteBCHCode::solve_affine(int c0, int c1, int c2, int rhs,
+                              int *out) const {
+  // Row with pivot bit p: L(pre[p]) = img[p], img[p] has highest bit p.
+  int img[16], pre[16];
+  bool used[16] = {};
+  int kernel[16], n_kernel = 0;
+
+  for (int k = 0; k < m; ++k) {
+    // Image of the basis element x^k = alpha^k
+    int v = gf_mul(c0, alpha_to[k]) ^ gf_mul(c1, alpha_to[(2 * k) % N]) ^
+            gf_mul(c2, alpha_to[(4 * k) % N]);
+    int x = 1 << k;
+    for (int p = m - 1; p >= 0 && v; --p) {
+      if (!((v >> p) & 1))
+        continue;
+      if (!used[p]) {
+        used[p] = true;
+        img[p] = v;
+        pre[p] = x;
+        v = 0;
+        x = 0;
+        break;
+      }
+      v ^= img[p];
+      x ^= pre[p];
+    }
+    if (x)
+      kernel[n_kernel++] = x;
+  }
+  if (n_kernel > 2)
+    return -1;
 
-    if (count == l[u]) {
-      for (i = 0; i < l[u]; i++)
-        if (loc[i] < N)
-          Y_N[loc[i]] ^= 1;
-      return 0; // Success
+  int z = 0;
+  for (int p = m - 1; p >= 0; --p) {
+    if (!((rhs >> p) & 1))
+      continue;
+    if (!used[p])
+      return 0;
+    rhs ^= img[p];
+    z ^= pre[p];
+  }
+
+  int n = 0;
+  for (int sel = 0; sel < (1 << n_kernel); ++sel) {
+    int v = z;
+    for (int k = 0; k < n_kernel; ++k)
+      if ((sel >> k) & 1)
+        v ^= kernel[k];
+    out[n++] = v;
+  }
+  return n;
+}
+
+// Same contract as chien_search for deg <= 4.
+int LiteBCHCode::low_degree_roots(const int *elp, int deg, int n_bits,
+                                  int *loc) const {
+  if (deg < 1)
+    return 0;
+
+  // sigma coefficients in polynomial form: sigma(z) = sum c[j] z^(deg - j)
+  int c[5] = {0};
+  for (int j = 0; j <= deg; ++j)
+    c[j] = (elp[j] == -1) ? 0 : alpha_to[elp[j]];
+  if (!c[deg])
+    return 0;
+
+  int cand[4];
+  int n_cand;
+  if (deg == 1) {
+    cand[0] = c[1];
+    n_cand = 1;
+  } else if (deg == 2) {
+    // z^2 + a z = b
+    n_cand = solve_affine(c[1], 1, 0, c[2], cand);
+  } else if (deg == 3) {
+    // (z + a)(z^3 + a z^2 + b z + c) = z^4 + (a^2 + b) z^2 + (ab + c) z + ac
+    int a = c[1], b = c[2], cc = c[3];
+    n_cand = solve_affine(gf_mul(a, b) ^ cc, gf_mul(a, a) ^ b, 1,
+                          gf_mul(a, cc), cand);
+  } else {
+    int a = c[1], b = c[2], cc = c[3], d = c[4];
+    if (!a) {
+      // z^4 + b z^2 + c z = d
+      n_cand = solve_affine(cc, b, 1, d, cand);
     } else {
-      return 1; // Failure
+      // z = y + e with e^2 = c / a removes the linear term:
+      //   y^4 + a y^3 + B y^2 + D, B = a e + b, D = sigma(e).
+      // With w = 1 / y: w^4 + (B / D) w^2 + (a / D) w = 1 / D.
+      int e = gf_sqrt(gf_div(cc, a));
+      int e2 = gf_mul(e, e);
+      int B = gf_mul(a, e) ^ b;
+      int D = gf_mul(e2, e2) ^ gf_mul(a, gf_mul(e2, e)) ^ gf_mul(b, e2) ^
+              gf_mul(cc, e) ^ d;
+      if (!D)
+        return 0; // Double root at z = e
+      n_cand = solve_affine(gf_div(a, D), gf_div(B, D), 1, gf_div(1, D), cand);
+      for (int k = 0; k < n_cand; ++k)
+        cand[k] = gf_div(1, cand[k]) ^ e;
     }
   }
-  return 1; // Failure
+
+  int count = 0;
+  for (int k = 0; k < n_cand; ++k) {
+    int z = cand[k];
+    if (!z)
+      continue;
+    int v = 0;
+    for (int j = 0; j <= deg; ++j)
+      v = gf_mul(v, z) ^ c[j];
+    if (v)
+      continue;
+    int pos = index_of[z];
+    if (pos >= n_bits)
+      return 0; // Root outside the codeword
+    loc[count++] = pos;
+  }
+  return count;
 }
 
 // ==========================================
 // Fast Byte-Oriented Decoding
 // ==========================================
-int LiteBCH::decode(uint8_t *data, size_t len, uint8_t *ecc) {
-  // 1. Syndrome Calculation via Re-Encoding
-  // S_j = (Ecc_calc + Ecc_recv)(alpha^j) since Data*x^r matches for both
-  // We compute syndromes on the XOR difference of ECCs.
+int LiteBCHCode::decode(uint8_t *data, size_t len, uint8_t *ecc,
+                        Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  return decode_core(data, len, ecc, ws);
+}
 
-  std::vector<int> s_poly(2 * t + 1, 0); // Syndromes
+int LiteBCHCode::decode_core(uint8_t *data, size_t len, uint8_t *ecc,
+                             Workspace &ws) const {
+  LITEBCH_STAT(ws.stat_begin());
+  bool errors = remainder_syndromes(data, len, ecc, ws);
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Syndromes));
+  if (!errors) {
+    LITEBCH_STAT(ws.stat_end(0, len));
+    return 0;
+  }
+  return correct_core(data, len, ecc, ws);
+}
 
-  // Compute Calc ECC
-  std::vector<uint8_t> calc_ecc(ecc_bytes, 0);
-  encode(data, len, calc_ecc.data());
+// --- Two-Stage Decoding ---
+// decode_core split at the syndromes; only the odd ones travel in s.
+bool LiteBCHCode::decode_detect(const uint8_t *data, size_t len,
+                                const uint8_t *ecc, int *s,
+                                Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  LITEBCH_STAT(ws.stat_begin());
+  bool errors = remainder_odd_syndromes(data, len, ecc, ws);
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Syndromes));
+  if (!errors) {
+    LITEBCH_STAT(ws.stat_end(0, len));
+    return false;
+  }
+  for (int i = 1; i < 2 * t; i += 2)
+    s[i] = ws.s[i];
+  return true;
+}
 
-  // XOR with Recv ECC to get difference polynomial
-  for (int i = 0; i < ecc_bytes; ++i) {
-    calc_ecc[i] ^= ecc[i];
+int LiteBCHCode::decode_correct(uint8_t *data, size_t len, uint8_t *ecc,
+                                const int *s, Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  LITEBCH_STAT(ws.stat_begin());
+  for (int i = 1; i < 2 * t; i += 2)
+    ws.s[i] = s[i];
+  bool errors = finish_syndromes(ws.s.data());
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Syndromes));
+  if (!errors) {
+    LITEBCH_STAT(ws.stat_end(0, len));
+    return 0;
   }
+  return correct_core(data, len, ecc, ws);
+}
 
-  // Precompute alpha^(8*i) exponents for fast Horner multiplication
-  // alpha_8_pow[i] stores 'k' such that alpha^k = (alpha^i)^8
-  std::vector<int> alpha_8_pow(2 * t + 1);
-  for (int i = 1; i <= 2 * t; ++i) {
-    alpha_8_pow[i] = (i * 8) % N;
+// Stages 2 to 4 on the syndromes in ws.s; ends the word's statistics.
+// 'hints' (sorted) are tried as roots before the search.
+int LiteBCHCode::correct_core(uint8_t *data, size_t len, uint8_t *ecc,
+                              Workspace &ws, const int *hints,
+                              size_t n_hints) const {
+  int deg = berlekamp_massey(ws);
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Locator));
+  if (deg < 0) {
+    LITEBCH_STAT(ws.stat_end(-1, len));
+    return -1;
   }
 
-  // Process ECC bytes from high index (high degree terms) to low index.
-  // This matches Horner's method evaluation.
-  int ecc_len = ecc_bytes;
-  for (int k = ecc_len - 1; k >= 0; --k) {
-    uint8_t b = calc_ecc[k];
-    if (k == ecc_len - 1) {
-      int valid_ecc = n_rdncy % 8;
-      if (valid_ecc != 0)
-        b &= ((1 << valid_ecc) - 1);
-    }
+  // Errors can only sit in the n_rdncy + data_bits(len) codeword bits; the
+  // root search covers just that window.
+  const int n_bits = n_rdncy + data_bits(len);
+  int count = n_hints ? hinted_roots(ws.lambda.data(), deg, n_bits, hints,
+                                     n_hints, ws.loc.data(), ws)
+                      : find_roots(ws.lambda.data(), deg, n_bits,
+                                   ws.loc.data(), ws);
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Roots));
+  if (count != deg) {
+    LITEBCH_STAT(ws.stat_end(-1, len));
+    return -1;
+  }
 
-    for (int i = 1; i <= 2 * t; ++i) {
-      if (s_poly[i] != 0) {
-        int idx = index_of[s_poly[i]];
-        idx = (idx + alpha_8_pow[i]) % N;
-        s_poly[i] = alpha_to[idx];
-      }
-      s_poly[i] ^= syndrome_lut[i][b];
-    }
+  correct_errors(data, len, ecc, count, ws);
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Correction));
+  LITEBCH_STAT(ws.stat_end(count, len));
+  return count;
+}
+
+// --- Error Detection ---
+// A clean word re-encodes to its own ECC; the remainder lands in ws.calc_ecc
+// and ws.par only, never in the decoder state. The padding bits above
+// ecc_bits in the last ECC byte are ignored, as in decode().
+bool LiteBCHCode::check(const uint8_t *data, size_t len, const uint8_t *ecc,
+                        Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  return check_core(data, len, ecc, ws);
+}
+
+bool LiteBCHCode::check_core(const uint8_t *data, size_t len,
+                             const uint8_t *ecc, Workspace &ws) const {
+  uint8_t *calc_ecc = ws.calc_ecc.data();
+  encode_core(data, len, calc_ecc, ws);
+
+  const int full = ecc_bits / 8;
+  if (std::memcmp(calc_ecc, ecc, full) != 0)
+    return false;
+  if (ecc_bits % 8) {
+    uint8_t mask = (uint8_t)((1 << (ecc_bits % 8)) - 1);
+    return ((calc_ecc[full] ^ ecc[full]) & mask) == 0;
   }
+  return true;
+}
+
+// Stage 1: syndromes S_1..S_2t (index form) in ws.s. Returns false if the
+// received word is a codeword.
+bool LiteBCHCode::remainder_syndromes(const uint8_t *data, size_t len,
+                                      const uint8_t *ecc,
+                                      Workspace &ws) const {
+  return remainder_odd_syndromes(data, len, ecc, ws) &&
+         finish_syndromes(ws.s.data());
+}
+
+// The odd syndromes in polynomial form, as odd_syndromes. Returns false
+// (with ws.s untouched) if the received word is a codeword.
+bool LiteBCHCode::remainder_odd_syndromes(const uint8_t *data, size_t len,
+                                          const uint8_t *ecc,
+                                          Workspace &ws) const {
+  need_encoder();
+  need_decoder();
+  auto &s = ws.s;
+
+  // Syndrome Calculation via Re-Encoding
+  // S_j = (Ecc_calc + Ecc_recv)(alpha^j) since Data*x^r matches for both.
+  // The difference is the remainder of the received word modulo g, which
+  // is zero iff every syndrome is zero.
+  uint8_t *calc_ecc = ws.calc_ecc.data();
+  encode_core(data, len, calc_ecc, ws);
+
+  uint8_t diff = 0;
+  for (int i = 0; i < ecc_bytes; ++i) {
+    calc_ecc[i] ^= ecc[i];
+    if (i == ecc_bytes - 1 && (ecc_bits % 8))
+      calc_ecc[i] &= (1 << (ecc_bits % 8)) - 1;
+    diff |= calc_ecc[i];
+  }
+  if (!diff)
+    return false;
+
+  // Highest degree byte first for the Horner evaluation
+  std::reverse(calc_ecc, calc_ecc + ecc_bytes);
+  if (wide())
+    wide_odd_syndromes(calc_ecc, ecc_bytes, s.data());
+  else
+    odd_syndromes(calc_ecc, ecc_bytes, s.data());
+  return true;
+}
 
-  // No combining needed! s_poly holds the full syndromes.
+// Completes s[1..2t] from its odd entries (polynomial form): the even
+// syndromes, then index form for berlekamp_massey (wide fields stay in
+// polynomial form). Returns false if every syndrome is zero.
+bool LiteBCHCode::finish_syndromes(int *s) const {
   bool syn_error = false;
-  for (int i = 1; i <= 2 * t; ++i) {
-    if (s_poly[i] != 0)
-      syn_error = true;
+  if (wide()) {
+    for (int i = 1; i < 2 * t; i += 2)
+      syn_error |= s[i] != 0;
+    for (int i = 2; i <= 2 * t; i += 2)
+      s[i] = (int)wide_mul((uint32_t)s[i / 2], (uint32_t)s[i / 2]);
+    return syn_error;
   }
+  even_syndromes(s);
 
   // Convert S to Index Form for Berlekamp
   for (int i = 1; i <= 2 * t; ++i) {
-    if (s_poly[i] != 0) {
-      s_poly[i] = index_of[s_poly[i]];
+    if (s[i] != 0) {
+      s[i] = index_of[s[i]];
       syn_error = true;
     } else {
-      s_poly[i] = -1; // -1 for Zero element in index form
+      s[i] = -1; // -1 for Zero element in index form
     }
   }
+  return syn_error;
+}
 
-  if (!syn_error)
+// Stage 2: error locator from ws.s, stored in index form in ws.lambda.
+// Returns its degree, or -1 if it exceeds t.
+//
+// Simplified Berlekamp-Massey for a binary code: S_2i = S_i^2 makes the
+// discrepancy of every second step zero, so only the t odd steps are run
+// and the correction term moves by x^2 per step. The state is two
+// polynomials of degree <= t (the locator and the one saved at the last
+// length change); nothing depends on N.
+int LiteBCHCode::berlekamp_massey(Workspace &ws) const {
+  if (wide())
+    return wide_berlekamp_massey(ws);
+  const int *s = ws.s.data();
+  int *lambda = ws.lambda.data(); // Polynomial form until the end
+  int *b = ws.bm_b.data();        // Saved locator, index form
+  int *prev = ws.bm_prev.data();
+
+  for (int i = 0; i <= t; i++)
+    lambda[i] = 0;
+  lambda[0] = 1;
+  b[0] = 0;
+  int L = 0;       // Locator length
+  int lb = 0;      // Degree bound of b
+  int shift = 1;   // lambda -= (d / d_b) x^shift b
+  int d_b = 0;     // log of the discrepancy at the last length change
+
+  for (int n = 0; n < 2 * t; n += 2) {
+    // d = S_(n+1) + sum lambda_i S_(n+1-i)
+    int d = (s[n + 1] != -1) ? (int)alpha_to[s[n + 1]] : 0;
+    for (int i = 1; i <= L; i++)
+      if (lambda[i] && s[n + 1 - i] != -1)
+        d ^= alpha_to[index_of[lambda[i]] + s[n + 1 - i]];
+    if (!d) {
+      shift += 2;
+      continue;
+    }
+
+    // log(d / d_b), in [0, N)
+    int ratio = index_of[d] - d_b;
+    if (ratio < 0)
+      ratio += N;
+    // A length change is where more than t errors show up; the updated
+    // locator would not fit, so stop before writing it.
+    bool grow = 2 * L <= n;
+    if (grow) {
+      if (n + 1 - L > t)
+        return -1;
+      for (int i = 0; i <= L; i++)
+        prev[i] = gf_log(lambda[i]);
+    }
+    // deg(x^shift b) <= new L <= t
+    for (int i = 0; i <= lb; i++)
+      if (b[i] != -1)
+        lambda[i + shift] ^= alpha_to[ratio + b[i]];
+
+    if (grow) {
+      std::swap(b, prev);
+      lb = L;
+      L = n + 1 - L;
+      d_b = index_of[d];
+      shift = 2;
+    } else {
+      shift += 2;
+    }
+  }
+
+  for (int i = 0; i <= L; i++)
+    lambda[i] = gf_log(lambda[i]);
+  return L;
+}
+
+// Stage 3: roots of the locator (degrees) in loc; see chien_search.
+int LiteBCHCode::find_roots(const int *elp, int deg, int n_bits, int *loc,
+                            Workspace &ws) const {
+  need_decoder();
+  if (wide())
+    return wide_find_roots(elp, deg, n_bits, loc, ws);
+  return (deg <= 4) ? low_degree_roots(elp, deg, n_bits, loc)
+                    : chien_search(elp, deg, n_bits, loc, ws);
+}
+
+// Stage 4: flip the 'count' bits found in ws.loc.
+void LiteBCHCode::correct_errors(uint8_t *data, size_t len, uint8_t *ecc,
+                                 int count, const Workspace &ws) const {
+  for (int i = 0; i < count; i++)
+    flip_bit(data, len, ecc, ws.loc[i]);
+}
+
+// Flips the coefficient of x^bit_idx of the codeword data + ecc.
+void LiteBCHCode::flip_bit(uint8_t *data, size_t len, uint8_t *ecc,
+                           int bit_idx) const {
+  if (bit_idx >= n_rdncy) {
+    int d_idx = bit_idx - n_rdncy;
+    // Data is packed High Degree First.
+    // d_idx is Degree (Low->High).
+    // Map Degree to Stream Position.
+    int stream_pos = data_bits(len) - 1 - d_idx;
+    int byte_idx = stream_pos / 8;
+    int bit_off = 7 - (stream_pos % 8);
+    if (byte_idx < (int)len) {
+      data[byte_idx] ^= (1 << bit_off);
+    }
+  } else {
+    int byte_idx = bit_idx / 8;
+    int bit_off = bit_idx % 8;
+    if (byte_idx < ecc_bytes) {
+      ecc[byte_idx] ^= (1 << bit_off);
+    }
+  }
+}
+
+// Value of the coefficient of x^bit_idx, as flip_bit addresses it.
+int LiteBCHCode::get_bit(const uint8_t *data, size_t len, const uint8_t *ecc,
+                         int bit_idx) const {
+  if (bit_idx >= n_rdncy) {
+    int stream_pos = data_bits(len) - 1 - (bit_idx - n_rdncy);
+    return (data[stream_pos / 8] >> (7 - stream_pos % 8)) & 1;
+  }
+  return (ecc[bit_idx / 8] >> (bit_idx % 8)) & 1;
+}
+
+// ==========================================
+// Erasures & Position Hints
+// ==========================================
+// Sorted, duplicate-free copy of the caller's positions in ws.side;
+// throws for a position outside the codeword window.
+void LiteBCHCode::load_positions(const int *pos, size_t n, size_t len,
+                                 Workspace &ws) const {
+  const int n_bits = n_rdncy + data_bits(len);
+  ws.side.assign(pos, pos + n);
+  std::sort(ws.side.begin(), ws.side.end());
+  ws.side.erase(std::unique(ws.side.begin(), ws.side.end()), ws.side.end());
+  if (!ws.side.empty() && (ws.side.front() < 0 || ws.side.back() >= n_bits))
+    throw std::invalid_argument("Bit positions must be in [0, N - K + " +
+                                std::to_string(data_bits(len)) + ")");
+}
+
+int LiteBCHCode::decode_hinted(uint8_t *data, size_t len, uint8_t *ecc,
+                               const int *hints, size_t n_hints,
+                               Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  load_positions(hints, n_hints, len, ws);
+  LITEBCH_STAT(ws.stat_begin());
+  bool errors = remainder_syndromes(data, len, ecc, ws);
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Syndromes));
+  if (!errors) {
+    LITEBCH_STAT(ws.stat_end(0, len));
     return 0;
+  }
+  return correct_core(data, len, ecc, ws, ws.side.data(), ws.side.size());
+}
 
-  // 2. Berlekamp-Massey (Copied logic)
-  this->s = s_poly;
+// Roots of the locator on the hinted positions first. Whatever is left is
+// divided out of the locator (in ws.bm_prev, free after berlekamp_massey)
+// and searched as a lower degree polynomial; when every error was hinted
+// there is no search at all. Same contract as find_roots.
+int LiteBCHCode::hinted_roots(const int *elp, int deg, int n_bits,
+                              const int *hints, size_t n_hints, int *loc,
+                              Workspace &ws) const {
+  need_decoder();
+  // Locator in polynomial form
+  int *q = ws.bm_prev.data();
+  for (int j = 0; j <= deg; ++j)
+    q[j] = wide() ? elp[j] : (elp[j] == -1 ? 0 : (int)alpha_to[elp[j]]);
+
+  int found = 0;
+  for (size_t h = 0; h < n_hints && found < deg; ++h) {
+    const int pos = hints[h];
+    // lambda(alpha^-pos) = sum q_j alpha^(-j pos)
+    int v = q[0];
+    for (int j = 1; j <= deg - found; ++j)
+      if (q[j])
+        v ^= wide() ? (int)wide_mul((uint32_t)q[j],
+                                    (uint32_t)gf_alpha(-(int64_t)j * pos))
+                    : gf_mul(q[j], gf_alpha(-(int64_t)j * pos));
+    if (v)
+      continue;
+    // q(x) / (1 + X x) with X = alpha^pos: q'_k = q_k + X q'_(k-1)
+    const int X = gf_alpha(pos);
+    const int d = deg - found;
+    int carry = 0;
+    for (int k = 0; k < d; ++k) {
+      int mul = wide() ? (int)wide_mul((uint32_t)X, (uint32_t)carry)
+                       : gf_mul(X, carry);
+      carry = q[k] ^ mul;
+      q[k] = carry;
+    }
+    q[d] = 0;
+    loc[found++] = pos;
+  }
+  if (found == deg)
+    return deg;
+
+  // The rest of the roots, none of them on a hinted root again
+  const int rest = deg - found;
+  if (!wide())
+    for (int j = 0; j <= rest; ++j)
+      q[j] = gf_log(q[j]);
+  int count = find_roots(q, rest, n_bits, loc + found, ws);
+  if (count != rest)
+    return found + count; // != deg: uncorrectable
+  for (int i = found; i < deg; ++i)
+    for (int k = 0; k < found; ++k)
+      if (loc[i] == loc[k])
+        return -1; // Repeated root
+  return deg;
+}
 
-  discrepancy[0] = 0;
-  discrepancy[1] = s[1];
-  elp[0][0] = 0;
-  elp[1][0] = 1;
-  int t2 = 2 * t;
-  for (int i = 1; i < t2; i++) {
-    elp[0][i] = -1;
-    elp[1][i] = 0;
-  }
-  l[0] = 0;
-  l[1] = 0;
-  u_lu[0] = -1;
-  u_lu[1] = 0;
-
-  int q, u = 0, j;
-  int N_p2_1 = N;
-
-  do {
-    u++;
-    if (discrepancy[u] == -1) {
-      l[u + 1] = l[u];
-      for (int i = 0; i <= l[u]; i++) {
-        elp[u + 1][i] = elp[u][i];
-        elp[u][i] = (int)index_of[elp[u][i]];
-      }
-    } else {
-      q = u - 1;
-      while ((discrepancy[q] == -1) && (q > 0))
-        q--;
-      if (q > 0) {
-        j = q;
-        do {
-          j--;
-          if ((discrepancy[j] != -1) && (u_lu[q] < u_lu[j]))
-            q = j;
-        } while (j > 0);
-      }
+// Binary erasure decoding in two trials: every erased bit set to 0, then to
+// 1. With v errors outside the erasures, the erased bits are wrong e0 times
+// in the first trial and e - e0 times in the second, so one trial has at
+// most v + e / 2 errors, i.e. <= t when 2v + e <= 2t. The trials' syndromes
+// are those of the received word plus the columns of the bits they change,
+// so the word is re-encoded once. The erasures are also the root hints.
+// Of the decoded trials, the one changing fewer bits outside the erasures
+// wins; within the guarantee only the sent codeword can reach v.
+int LiteBCHCode::decode_erasures(uint8_t *data, size_t len, uint8_t *ecc,
+                                 const int *erasures, size_t n_erasures,
+                                 Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  load_positions(erasures, n_erasures, len, ws);
+  const int e = (int)ws.side.size();
+  const int *side = ws.side.data();
+  if (e == 0)
+    return decode_core(data, len, ecc, ws);
+
+  // Odd syndromes of the received word, then of both trials [2][t]
+  LITEBCH_STAT(ws.stat_begin());
+  int *s = ws.s.data();
+  if (!remainder_odd_syndromes(data, len, ecc, ws))
+    for (int i = 1; i < 2 * t; i += 2)
+      s[i] = 0;
+  if (ws.chase_syn.size() < (size_t)2 * t)
+    ws.chase_syn.resize((size_t)2 * t);
+  if (ws.chase_best.size() < (size_t)t)
+    ws.chase_best.resize(t);
+  int *trial = ws.chase_syn.data();
+  for (int j = 0; j < t; ++j)
+    trial[j] = trial[t + j] = s[2 * j + 1];
+  for (int k = 0; k < e; ++k) {
+    // Trial 0 changes the erased 1s, trial 1 the erased 0s
+    int *tr = trial + (get_bit(data, len, ecc, side[k]) ? 0 : t);
+    for (int j = 0; j < t; ++j)
+      tr[j] ^= gf_alpha((int64_t)(2 * j + 1) * side[k]);
+  }
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Syndromes));
 
-      if (l[u] > l[q] + u - q)
-        l[u + 1] = l[u];
-      else
-        l[u + 1] = l[q] + u - q;
-
-      for (int i = 0; i < t2; i++)
-        elp[u + 1][i] = 0;
-      for (int i = 0; i <= l[q]; i++)
-        if (elp[q][i] != -1)
-          elp[u + 1][i + u - q] = (int)
-              alpha_to[(discrepancy[u] + N_p2_1 - discrepancy[q] + elp[q][i]) %
-                       N_p2_1];
-      for (int i = 0; i <= l[u]; i++) {
-        elp[u + 1][i] ^= elp[u][i];
-        elp[u][i] = (int)index_of[elp[u][i]];
-      }
+  int best = -1, best_outside = 0, best_count = 0;
+  for (int b = 0; b < 2; ++b) {
+    for (int j = 0; j < t; ++j)
+      s[2 * j + 1] = trial[b * t + j];
+    int count = 0;
+    bool errors = finish_syndromes(s);
+    LITEBCH_STAT(ws.stat_lap(DecodeStats::Syndromes));
+    if (errors) {
+      int deg = berlekamp_massey(ws);
+      LITEBCH_STAT(ws.stat_lap(DecodeStats::Locator));
+      if (deg < 0)
+        continue;
+      count = hinted_roots(ws.lambda.data(), deg, n_rdncy + data_bits(len),
+                           side, e, ws.loc.data(), ws);
+      LITEBCH_STAT(ws.stat_lap(DecodeStats::Roots));
+      if (count != deg)
+        continue;
     }
-    u_lu[u + 1] = u - l[u + 1];
+    int outside = 0;
+    for (int i = 0; i < count; ++i)
+      outside += !std::binary_search(side, side + e, ws.loc[i]);
+    if (best >= 0 && outside >= best_outside)
+      continue;
+    best = b;
+    best_outside = outside;
+    best_count = count;
+    std::copy(ws.loc.begin(), ws.loc.begin() + count, ws.chase_best.begin());
+  }
+  if (best < 0) {
+    LITEBCH_STAT(ws.stat_end(-1, len));
+    return -1;
+  }
+
+  // Net changes: the trial's erased bits, then its locator roots, which may
+  // flip some of those back.
+  int changed = 0;
+  for (int k = 0; k < e; ++k) {
+    int *p = &ws.side[k];
+    if (get_bit(data, len, ecc, *p) != best) {
+      flip_bit(data, len, ecc, *p);
+      *p = ~*p; // Marks the bit as changed
+      ++changed;
+    }
+  }
+  for (int i = 0; i < best_count; ++i) {
+    const int bit = ws.chase_best[i];
+    flip_bit(data, len, ecc, bit);
+    bool undo = false;
+    for (int k = 0; k < e; ++k)
+      undo |= ws.side[k] == ~bit;
+    changed += undo ? -1 : 1;
+  }
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Correction));
+  LITEBCH_STAT(ws.stat_end(changed, len));
+  return changed;
+}
 
-    if (u < t2) {
-      if (s[u + 1] != -1)
-        discrepancy[u + 1] = (int)alpha_to[s[u + 1]];
-      else
-        discrepancy[u + 1] = 0;
+// ==========================================
+// Chase-II Soft Decoding
+// ==========================================
+// Every test pattern is the hard decision plus a subset of the p least
+// reliable bits. Syndromes are linear, so a pattern's odd syndromes are
+// those of the hard decision plus one column of alpha^(i * pos) per flipped
+// bit. The patterns are visited in Gray code order: each one differs from
+// the previous one in a single bit, i.e. t XORs instead of a re-encode, and
+// only the locator and root search run per pattern. The candidate with the
+// smallest sum of |llr| over the bits it changes wins.
+//
+// A candidate whose locator has a root on a test position is also the
+// candidate of the pattern with that bit toggled, with one error less, so
+// only candidates with every root outside the test positions are scored.
+// Such a root costs at least the largest test reliability, which bounds the
+// score from the pattern and the locator degree alone: most patterns are
+// dropped before the root search.
+int LiteBCHCode::decode_chase(uint8_t *data, size_t len, uint8_t *ecc,
+                              const float *llr, int p, Workspace &ws) const {
+  check_len(len);
+  if (p < 0 || p > max_chase_positions)
+    throw std::invalid_argument("Chase positions must be in [0, 16]");
+  ws.prepare(*this);
+  return chase_core(data, len, ecc, llr, p, ws);
+}
+
+int LiteBCHCode::chase_core(uint8_t *data, size_t len, uint8_t *ecc,
+                            const float *llr, int p, Workspace &ws) const {
+  LITEBCH_STAT(ws.stat_begin());
+  int *s = ws.s.data();
+  if (!remainder_odd_syndromes(data, len, ecc, ws)) {
+    LITEBCH_STAT(ws.stat_lap(DecodeStats::Syndromes));
+    LITEBCH_STAT(ws.stat_end(0, len));
+    return 0; // The hard decision is a codeword: nothing is cheaper
+  }
 
-      for (int i = 1; i <= l[u + 1]; i++)
-        if ((s[u + 1 - i] != -1) && (elp[u + 1][i] != 0))
-          discrepancy[u + 1] ^=
-              alpha_to[(s[u + 1 - i] + index_of[elp[u + 1][i]]) % N_p2_1];
-      discrepancy[u + 1] = (int)index_of[discrepancy[u + 1]];
+  // The p least reliable bits of the window, most reliable last
+  const int n_bits = n_rdncy + data_bits(len);
+  p = std::min(p, n_bits);
+  int pos[max_chase_positions];
+  float rel[max_chase_positions];
+  int n_pos = 0;
+  for (int j = 0; j < n_bits && p; ++j) {
+    const float a = std::fabs(llr[j]);
+    if (n_pos == p && !(a < rel[p - 1]))
+      continue;
+    int k = (n_pos < p) ? n_pos++ : p - 1;
+    for (; k > 0 && a < rel[k - 1]; --k) {
+      pos[k] = pos[k - 1];
+      rel[k] = rel[k - 1];
     }
-  } while ((u < t2) && (l[u + 1] <= t));
+    pos[k] = j;
+    rel[k] = a;
+  }
 
-  u++;
-  if (l[u] <= t) {
-    for (int i = 0; i <= l[u]; i++)
-      elp[u][i] = (int)index_of[elp[u][i]];
+  // Odd syndrome columns of the test positions, then the running syndromes
+  if (ws.chase_syn.size() < (size_t)(n_pos + 1) * t)
+    ws.chase_syn.resize((size_t)(n_pos + 1) * t);
+  if (ws.chase_best.size() < (size_t)t)
+    ws.chase_best.resize(t);
+  int *col = ws.chase_syn.data();
+  int *cur = col + n_pos * t;
+  for (int k = 0; k < n_pos; ++k)
+    for (int j = 0; j < t; ++j)
+      col[k * t + j] = gf_alpha((int64_t)(2 * j + 1) * pos[k]);
+  for (int j = 0; j < t; ++j)
+    cur[j] = s[2 * j + 1];
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Syndromes));
+
+  // Per pattern, the syndrome update and scoring count towards the locator
+  const double floor_rel = n_pos ? rel[n_pos - 1] : 0;
+  double best = -1;
+  uint32_t best_mask = 0;
+  int best_count = 0;
+  uint32_t mask = 0;
+  double flipped = 0; // sum of |llr| over the pattern
+  for (uint32_t n = 0; n < (1u << n_pos); ++n) {
+    if (n) {
+      int k = 0; // The Gray code changes bit ctz(n)
+      while (!((n >> k) & 1))
+        ++k;
+      mask ^= 1u << k;
+      flipped += (mask >> k & 1) ? rel[k] : -rel[k];
+      for (int j = 0; j < t; ++j)
+        cur[j] ^= col[k * t + j];
+    }
+    if (best >= 0 && !(flipped < best))
+      continue;
+    for (int j = 0; j < t; ++j)
+      s[2 * j + 1] = cur[j];
 
-    for (int i = 1; i <= l[u]; i++)
-      reg[i] = elp[u][i];
     int count = 0;
-    // Chien Search Optimization: Remove modulo
-    for (int i = 1; i <= N_p2_1; i++) {
-      q = 1;
-      for (int j = 1; j <= l[u]; j++)
-        if (reg[j] != -1) {
-          int val = reg[j] + j;
-          if (val >= N_p2_1)
-            val -= N_p2_1;
-          reg[j] = val;
-          q ^= alpha_to[val];
-        }
-      if (!q) {
-        loc[count++] = N_p2_1 - i;
+    double metric = flipped;
+    if (finish_syndromes(s)) {
+      int deg = berlekamp_massey(ws);
+      LITEBCH_STAT(ws.stat_lap(DecodeStats::Locator));
+      if (deg < 0 || (best >= 0 && !(flipped + deg * floor_rel < best)))
+        continue;
+      count = find_roots(ws.lambda.data(), deg, n_bits, ws.loc.data(), ws);
+      LITEBCH_STAT(ws.stat_lap(DecodeStats::Roots));
+      if (count != deg)
+        continue;
+      bool on_test = false;
+      for (int i = 0; i < count; ++i) {
+        for (int k = 0; k < n_pos; ++k)
+          on_test |= pos[k] == ws.loc[i];
+        metric += std::fabs(llr[ws.loc[i]]);
       }
+      if (on_test)
+        continue;
     }
+    if (best >= 0 && !(metric < best))
+      continue;
+    best = metric;
+    best_mask = mask;
+    best_count = count;
+    std::copy(ws.loc.begin(), ws.loc.begin() + count, ws.chase_best.begin());
+  }
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Locator));
+  if (best < 0) {
+    LITEBCH_STAT(ws.stat_end(-1, len));
+    return -1;
+  }
 
-    if (count == l[u]) {
-      for (int i = 0; i < l[u]; i++) {
-        int bit_idx = loc[i];
-        if (bit_idx >= n_rdncy) {
-          int d_idx = bit_idx - n_rdncy;
-          // Data is packed High Degree First.
-          // d_idx is Degree (Low->High).
-          // Map Degree to Stream Position.
-          int stream_pos = K - 1 - d_idx;
-          int byte_idx = stream_pos / 8;
-          int bit_off = 7 - (stream_pos % 8);
-          if (byte_idx < (int)len) {
-            data[byte_idx] ^= (1 << bit_off);
-          }
-        } else {
-          int byte_idx = bit_idx / 8;
-          int bit_off = bit_idx % 8;
-          if (byte_idx < ecc_bytes) {
-            ecc[byte_idx] ^= (1 << bit_off);
-          }
-        }
-      }
-      return count;
-    } else {
-      return -1;
+  // The pattern and the locator's roots are disjoint
+  int changed = best_count;
+  for (int k = 0; k < n_pos; ++k)
+    if (best_mask >> k & 1) {
+      flip_bit(data, len, ecc, pos[k]);
+      ++changed;
     }
+  for (int i = 0; i < best_count; ++i)
+    flip_bit(data, len, ecc, ws.chase_best[i]);
+  LITEBCH_STAT(ws.stat_lap(DecodeStats::Correction));
+  LITEBCH_STAT(ws.stat_end(changed, len));
+  return changed;
+}
+
+// ==========================================
+// Batch API
+// ==========================================
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LITEBCH_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define LITEBCH_PREFETCH(addr) ((void)0)
+#endif
+
+void LiteBCHCode::encode_batch(const uint8_t *data, size_t len, size_t stride,
+                               size_t count, uint8_t *ecc, size_t ecc_stride,
+                               Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  size_t c = 0;
+  // The lockstep step costs one shuffle pair per remainder byte for all
+  // lanes. Past about two remainder bytes per lane the plane traffic
+  // outweighs the parallelism and the slice-by-4 encoder wins; the
+  // carry-less encoder already wins past a quarter of a byte per lane.
+  const simd::Kernels &kern = simd::active_kernels();
+  const int max_planes =
+      simd::active_clmul().encode ? kern.lanes / 4 : 2 * kern.lanes;
+  if (kern.encode && data_bits(len) >= 128 && 4 * ecc_words <= max_planes) {
+    const size_t lanes = kern.lanes;
+    for (; c + lanes <= count; c += lanes)
+      encode_lanes(data + c * stride, len, stride, ecc + c * ecc_stride,
+                   ecc_stride, ws);
   }
-  return -1;
+  for (; c < count; ++c) {
+    if (c + 1 < count)
+      LITEBCH_PREFETCH(data + (c + 1) * stride);
+    encode_core(data + c * stride, len, ecc + c * ecc_stride, ws);
+  }
+}
+
+size_t LiteBCHCode::decode_batch(uint8_t *data, size_t len, size_t stride,
+                                 size_t count, uint8_t *ecc, size_t ecc_stride,
+                                 int *errors, Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  size_t failed = 0;
+  for (size_t c = 0; c < count; ++c) {
+    if (c + 1 < count) {
+      LITEBCH_PREFETCH(data + (c + 1) * stride);
+      LITEBCH_PREFETCH(ecc + (c + 1) * ecc_stride);
+    }
+    int res = decode_core(data + c * stride, len, ecc + c * ecc_stride, ws);
+    if (res < 0)
+      failed++;
+    if (errors)
+      errors[c] = res;
+  }
+  return failed;
+}
+
+size_t LiteBCHCode::check_batch(const uint8_t *data, size_t len, size_t stride,
+                                size_t count, const uint8_t *ecc,
+                                size_t ecc_stride, bool *valid,
+                                Workspace &ws) const {
+  check_len(len);
+  ws.prepare(*this);
+  size_t invalid = 0;
+  for (size_t c = 0; c < count; ++c) {
+    if (c + 1 < count) {
+      LITEBCH_PREFETCH(data + (c + 1) * stride);
+      LITEBCH_PREFETCH(ecc + (c + 1) * ecc_stride);
+    }
+    bool ok = check_core(data + c * stride, len, ecc + c * ecc_stride, ws);
+    if (!ok)
+      invalid++;
+    if (valid)
+      valid[c] = ok;
+  }
+  return invalid;
+}
+
+// --- Backends ---
+
+namespace {
+
+template <class K>
+std::vector<std::string> usable_names(const K *const *all, int n) {
+  std::vector<std::string> names;
+  for (int i = 0; i < n; ++i)
+    if (simd::usable(*all[i]))
+      names.push_back(all[i]->name);
+  return names;
+}
+
+// Null for "auto"; throws for an unknown or unusable name.
+template <class K>
+const K *find_backend(const K *const *all, int n, const std::string &name) {
+  if (name == "auto")
+    return nullptr;
+  for (int i = 0; i < n; ++i) {
+    if (name == all[i]->name) {
+      if (!simd::usable(*all[i]))
+        throw std::invalid_argument("Backend not available here: " +
+                                    name);
+      return all[i];
+    }
+  }
+  throw std::invalid_argument("Unknown backend: " + name);
+}
+
+} // namespace
+
+std::vector<std::string> vector_backends() {
+  return usable_names(simd::all_kernels, simd::n_kernels);
+}
+
+std::string get_vector_backend() { return simd::active_kernels().name; }
+
+void set_vector_backend(const std::string &name) {
+  simd::set_active_kernels(
+      find_backend(simd::all_kernels, simd::n_kernels, name));
+}
+
+std::vector<std::string> encode_backends() {
+  return usable_names(simd::all_clmul, simd::n_clmul);
+}
+
+std::string get_encode_backend() { return simd::active_clmul().name; }
+
+void set_encode_backend(const std::string &name) {
+  simd::set_active_clmul(find_backend(simd::all_clmul, simd::n_clmul, name));
 }
 
 std::vector<LiteBCH::B> string_to_bits(const std::string &str) {
@@ -0,0 +1,392 @@
+#include <algorithm>
+#include <litebch/ParallelBCH.h>
+
+#include "simd/kernels.h"
+
+namespace lite {
+
+// ==========================================
+// Work-Stealing Pool
+// ==========================================
+
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  n_workers = threads;
+  ranges.reset(new Range[n_workers]);
+
+  // Worker 0 is the thread calling parallel_for.
+  this->threads.reserve(n_workers - 1);
+  for (unsigned w = 1; w < n_workers; ++w)
+    this->threads.emplace_back(&WorkStealingPool::worker_loop, this, w);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &th : threads)
+    th.join();
+}
+
+void WorkStealingPool::parallel_for(
+    size_t count, size_t chunk,
+    const std::function<void(size_t, size_t, unsigned)> &fn) {
+  if (count == 0)
+    return;
+  if (chunk == 0)
+    chunk = 1;
+
+  Job current;
+  current.fn = &fn;
+  current.count = count;
+  current.chunk = chunk;
+
+  // Initial static split; stealing evens out whatever imbalance is left.
+  size_t n_chunks = (count + chunk - 1) / chunk;
+  for (unsigned w = 0; w < n_workers; ++w) {
+    std::lock_guard<std::mutex> lk(ranges[w].lock);
+    ranges[w].lo = n_chunks * w / n_workers;
+    ranges[w].hi = n_chunks * (w + 1) / n_workers;
+  }
+
+  if (n_workers > 1) {
+    std::lock_guard<std::mutex> lk(mutex);
+    job = &current;
+    busy = n_workers - 1;
+    generation++;
+  }
+  wake.notify_all();
+
+  run(current, 0);
+
+  if (n_workers > 1) {
+    std::unique_lock<std::mutex> lk(mutex);
+    done.wait(lk, [this] { return busy == 0; });
+    job = nullptr;
+  }
+
+  if (current.error)
+    std::rethrow_exception(current.error);
+}
+
+void WorkStealingPool::worker_loop(unsigned worker) {
+  uint64_t seen = 0;
+  for (;;) {
+    Job *current;
+    {
+      std::unique_lock<std::mutex> lk(mutex);
+      wake.wait(lk, [&] { return stopping || generation != seen; });
+      if (stopping)
+        return;
+      seen = generation;
+      current = job;
+    }
+
+    run(*current, worker);
+
+    std::lock_guard<std::mutex> lk(mutex);
+    if (--busy == 0)
+      done.notify_all();
+  }
+}
+
+void WorkStealingPool::run(Job &current, unsigned worker) {
+  size_t c;
+  while (pop(worker, c) || steal(worker, c)) {
+    size_t begin = c * current.chunk;
+    size_t end = std::min(current.count, begin + current.chunk);
+    try {
+      (*current.fn)(begin, end, worker);
+    } catch (...) {
+      std::lock_guard<std::mutex> lk(current.error_mutex);
+      if (!current.error)
+        current.error = std::current_exception();
+    }
+  }
+}
+
+bool WorkStealingPool::pop(unsigned worker, size_t &chunk_idx) {
+  Range &r = ranges[worker];
+  std::lock_guard<std::mutex> lk(r.lock);
+  if (r.lo >= r.hi)
+    return false;
+  chunk_idx = r.lo++;
+  return true;
+}
+
+bool WorkStealingPool::steal(unsigned thief, size_t &chunk_idx) {
+  for (unsigned k = 1; k < n_workers; ++k) {
+    Range &victim = ranges[(thief + k) % n_workers];
+    size_t lo, hi;
+    {
+      std::lock_guard<std::mutex> lk(victim.lock);
+      size_t left = victim.hi - std::min(victim.lo, victim.hi);
+      if (left == 0)
+        continue;
+      hi = victim.hi;
+      victim.hi -= (left + 1) / 2;
+      lo = victim.hi;
+    }
+    // Run the first stolen chunk now, expose the rest for further stealing.
+    chunk_idx = lo;
+    Range &own = ranges[thief];
+    std::lock_guard<std::mutex> lk(own.lock);
+    own.lo = lo + 1;
+    own.hi = hi;
+    return true;
+  }
+  return false;
+}
+
+// ==========================================
+// Parallel Batch Codec
+// ==========================================
+
+ParallelBCH::ParallelBCH(std::shared_ptr<const LiteBCHCode> code,
+                         unsigned threads, size_t chunk)
+    : code(std::move(code)), pool(threads), chunk(chunk) {
+  if (!this->code)
+    throw std::invalid_argument("ParallelBCH requires a non-null code");
+  workspaces.reserve(pool.get_threads());
+  for (unsigned w = 0; w < pool.get_threads(); ++w)
+    workspaces.emplace_back(*this->code);
+}
+
+LiteBCHCode::DecodeStats ParallelBCH::stats() const {
+  LiteBCHCode::DecodeStats total;
+  for (const auto &ws : workspaces)
+    total.merge(ws.stats());
+  return total;
+}
+
+void ParallelBCH::reset_stats() {
+  for (auto &ws : workspaces)
+    ws.reset_stats();
+}
+
+void ParallelBCH::set_trace_hook(LiteBCHCode::TraceHook hook, void *user) {
+  for (auto &ws : workspaces)
+    ws.set_trace_hook(hook, user);
+}
+
+size_t ParallelBCH::chunk_for(size_t count) const {
+  if (chunk)
+    return chunk;
+  // About 8 chunks per worker: enough room to rebalance, few lock trips.
+  size_t target = (size_t)pool.get_threads() * 8;
+  return std::max<size_t>(1, (count + target - 1) / target);
+}
+
+void ParallelBCH::encode_batch(const uint8_t *data, size_t len, size_t stride,
+                               size_t count, uint8_t *ecc, size_t ecc_stride) {
+  // Derived chunks hold whole lockstep groups (see LiteBCHCode::encode_batch)
+  size_t n = chunk_for(count);
+  const size_t lanes = simd::active_kernels().lanes;
+  if (!chunk && lanes)
+    n = (n + lanes - 1) / lanes * lanes;
+  pool.parallel_for(count, n,
+                    [&](size_t begin, size_t end, unsigned w) {
+                      code->encode_batch(data + begin * stride, len, stride,
+                                         end - begin, ecc + begin * ecc_stride,
+                                         ecc_stride, workspaces[w]);
+                    });
+}
+
+size_t ParallelBCH::decode_batch(uint8_t *data, size_t len, size_t stride,
+                                 size_t count, uint8_t *ecc, size_t ecc_stride,
+                                 int *errors) {
+  std::vector<size_t> failed(pool.get_threads(), 0);
+  pool.parallel_for(count, chunk_for(count),
+                    [&](size_t begin, size_t end, unsigned w) {
+                      failed[w] += code->decode_batch(
+                          data + begin * stride, len, stride, end - begin,
+                          ecc + begin * ecc_stride, ecc_stride,
+                          errors ? errors + begin : nullptr, workspaces[w]);
+                    });
+  size_t total = 0;
+  for (size_t f : failed)
+    total += f;
+  return total;
+}
+
+size_t ParallelBCH::check_batch(const uint8_t *data, size_t len, size_t stride,
+                                size_t count, const uint8_t *ecc,
+                                size_t ecc_stride, bool *valid) {
+  std::vector<size_t> invalid(pool.get_threads(), 0);
+  pool.parallel_for(count, chunk_for(count),
+                    [&](size_t begin, size_t end, unsigned w) {
+                      invalid[w] += code->check_batch(
+                          data + begin * stride, len, stride, end - begin,
+                          ecc + begin * ecc_stride, ecc_stride,
+                          valid ? valid + begin : nullptr, workspaces[w]);
+                    });
+  size_t total = 0;
+  for (size_t f : invalid)
+    total += f;
+  return total;
+}
+
+// ==========================================
+// Decode Pipeline
+// ==========================================
+
+DecodePipeline::DecodePipeline(std::shared_ptr<const LiteBCHCode> code,
+                               unsigned threads, size_t capacity)
+    : code(std::move(code)), detect_q(capacity), correct_q(capacity) {
+  if (!this->code)
+    throw std::invalid_argument("DecodePipeline requires a non-null code");
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  workspaces.reserve(threads);
+  for (unsigned w = 0; w < threads; ++w)
+    workspaces.emplace_back(*this->code);
+  this->threads.reserve(threads);
+  for (unsigned w = 0; w < threads; ++w)
+    this->threads.emplace_back(&DecodePipeline::worker_loop, this, w);
+}
+
+DecodePipeline::~DecodePipeline() {
+  drain();
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &th : threads)
+    th.join();
+}
+
+bool DecodePipeline::try_submit(uint8_t *data, size_t len, uint8_t *ecc,
+                                Callback done) {
+  const size_t max_len = (size_t)(code->get_K() + 7) / 8;
+  if (len > max_len)
+    throw std::invalid_argument(
+        "Message length must be at most (K + 7) / 8 = " +
+        std::to_string(max_len) + " bytes");
+  Request req;
+  req.data = data;
+  req.len = len;
+  req.ecc = ecc;
+  req.done = std::move(done);
+  pending++;
+  queued++;
+  if (!detect_q.try_push(req)) {
+    queued--;
+    release();
+    return false;
+  }
+  wake_worker();
+  return true;
+}
+
+std::future<int> DecodePipeline::try_submit(uint8_t *data, size_t len,
+                                            uint8_t *ecc) {
+  std::shared_ptr<std::promise<int>> result =
+      std::make_shared<std::promise<int>>();
+  std::future<int> future = result->get_future();
+  if (!try_submit(data, len, ecc, [result](int r) { result->set_value(r); }))
+    return std::future<int>();
+  return future;
+}
+
+LiteBCHCode::DecodeStats DecodePipeline::stats() const {
+  LiteBCHCode::DecodeStats total;
+  for (const auto &ws : workspaces)
+    total.merge(ws.stats());
+  return total;
+}
+
+void DecodePipeline::reset_stats() {
+  for (auto &ws : workspaces)
+    ws.reset_stats();
+}
+
+void DecodePipeline::set_trace_hook(LiteBCHCode::TraceHook hook,
+                                    void *user) {
+  for (auto &ws : workspaces)
+    ws.set_trace_hook(hook, user);
+}
+
+void DecodePipeline::drain() {
+  std::unique_lock<std::mutex> lk(mutex);
+  idle.wait(lk, [this] { return pending.load() == 0; });
+}
+
+// 'queued' is raised before a push and lowered after a pop, so it never
+// undercounts. A sleeping worker re-checks it after announcing itself in
+// 'sleeping', and a producer checks 'sleeping' after raising it (both
+// sequentially consistent), so one of them sees the other: either the
+// worker finds the item or the producer takes the lock and wakes it. The
+// I/O thread only touches the mutex when a worker is asleep.
+void DecodePipeline::wake_worker() {
+  if (sleeping.load()) {
+    { std::lock_guard<std::mutex> lk(mutex); }
+    wake.notify_one();
+  }
+}
+
+void DecodePipeline::complete(Request &req, int result) {
+  Callback done = std::move(req.done);
+  req.done = nullptr;
+  if (done)
+    done(result);
+  release();
+}
+
+void DecodePipeline::release() {
+  if (--pending == 0) {
+    { std::lock_guard<std::mutex> lk(mutex); }
+    idle.notify_all();
+  }
+}
+
+void DecodePipeline::worker_loop(unsigned worker) {
+  LiteBCHCode::Workspace &ws = workspaces[worker];
+  const size_t n_syn = 2 * code->get_t() + 1;
+  Request req;
+  Located loc;
+  for (;;) {
+    // Stage 2: words with errors
+    if (correct_q.try_pop(loc)) {
+      queued--;
+      int r = code->decode_correct(loc.req.data, loc.req.len, loc.req.ecc,
+                                   loc.s.data(), ws);
+      complete(loc.req, r);
+      continue;
+    }
+
+    // Stage 1: re-encode and syndromes; clean words are done here
+    if (detect_q.try_pop(req)) {
+      queued--;
+      if (loc.s.size() < n_syn)
+        loc.s.resize(n_syn); // A cell's buffer comes back on each push
+      if (!code->decode_detect(req.data, req.len, req.ecc, loc.s.data(),
+                               ws)) {
+        complete(req, 0);
+        continue;
+      }
+      std::swap(loc.req, req);
+      queued++; // This worker takes it next unless another one does
+      if (!correct_q.try_push(loc)) {
+        queued--;
+        // Stage 2 is full: finish the word here rather than wait
+        int r = code->decode_correct(loc.req.data, loc.req.len, loc.req.ecc,
+                                     loc.s.data(), ws);
+        complete(loc.req, r);
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lk(mutex);
+    sleeping++;
+    wake.wait(lk, [this] { return stopping || queued.load() > 0; });
+    sleeping--;
+    if (stopping && queued.load() == 0)
+      return;
+  }
+}
+
+} // namespace lite
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <litebch/LiteBCH.h>
+
+#if defined(__PCLMUL__) && defined(__x86_64__)
+#include <wmmintrin.h>
+#endif
+
+// GF(2^m) for 17 <= m <= 24, without log tables (see LiteBCH.h). Elements
+// are in polynomial form throughout: bit k is the coefficient of alpha^k.
+
+namespace lite {
+
+namespace {
+
+// x * c through the byte-split table of c (see wide_const_table)
+inline uint32_t mul_const(const uint32_t *tab, uint32_t x) {
+  return tab[x & 0xff] ^ tab[256 + ((x >> 8) & 0xff)] ^ tab[512 + (x >> 16)];
+}
+
+} // namespace
+
+void LiteBCHCode::init_wide_field() {
+  gf_poly = 0;
+  for (int i = 0; i <= m; ++i)
+    if (p[i])
+      gf_poly |= 1u << i;
+
+  // wide_reduce[h] = h(x) * x^m mod p, one bit of h at a time
+  wide_reduce.assign(256, 0);
+  const uint32_t top = 1u << m;
+  uint32_t xk = gf_poly ^ top; // x^m mod p
+  for (int k = 0; k < 8; ++k) {
+    for (int h = 1 << k; h < (2 << k); ++h)
+      wide_reduce[h] = wide_reduce[h ^ (1 << k)] ^ xk;
+    xk <<= 1;
+    if (xk & top)
+      xk ^= gf_poly;
+  }
+}
+
+uint32_t LiteBCHCode::wide_mul(uint32_t a, uint32_t b) const {
+#if defined(__PCLMUL__) && defined(__x86_64__)
+  __m128i prod = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int)a),
+                                      _mm_cvtsi32_si128((int)b), 0);
+  uint64_t r = (uint64_t)_mm_cvtsi128_si64(prod);
+#else
+  // Carry-less multiply, 4 bits of b per step
+  uint64_t tab[16];
+  tab[0] = 0;
+  tab[1] = a;
+  for (int k = 2; k < 16; k += 2) {
+    tab[k] = tab[k / 2] << 1;
+    tab[k + 1] = tab[k] ^ a;
+  }
+  uint64_t r = 0;
+  for (int sh = (m + 3) / 4 * 4 - 4; sh >= 0; sh -= 4)
+    r = (r << 4) ^ tab[(b >> sh) & 15];
+#endif
+  // Fold the bits above x^m (degree <= 2m - 2), highest byte first
+  for (int sh = m + 16; sh >= m; sh -= 8) {
+    uint32_t h = (uint32_t)(r >> sh) & 0xff;
+    r ^= (uint64_t)h << sh;
+    r ^= (uint64_t)wide_reduce[h] << (sh - m);
+  }
+  return (uint32_t)r;
+}
+
+uint32_t LiteBCHCode::wide_pow(uint32_t a, uint64_t e) const {
+  uint32_t r = 1;
+  for (; e; e >>= 1) {
+    if (e & 1)
+      r = wide_mul(r, a);
+    a = wide_mul(a, a);
+  }
+  return r;
+}
+
+// tab[k * 256 + b] = (b << 8k) * c, so x * c is three lookups
+void LiteBCHCode::wide_const_table(uint32_t c, uint32_t *tab) const {
+  for (int k = 0; k < 3; ++k) {
+    uint32_t *row = tab + 256 * k;
+    row[0] = 0;
+    uint32_t bit = c; // c * x^(8k + j)
+    for (int j = 0; j < 8 * k; ++j)
+      bit = wide_mul(bit, 2);
+    for (int j = 0; j < 8; ++j) {
+      for (int b = 1 << j; b < (2 << j); ++b)
+        row[b] = row[b ^ (1 << j)] ^ bit;
+      bit = wide_mul(bit, 2);
+    }
+  }
+}
+
+void LiteBCHCode::init_wide_decode_tables() const {
+  // Odd syndromes of one byte (bit k = coefficient of x^k), and the Horner
+  // step alpha^(8i)
+  wide_syn_lut.assign(t * 256, 0);
+  wide_syn_step.assign(t * 768, 0);
+  for (int j = 0; j < t; ++j) {
+    const int i = 2 * j + 1;
+    uint32_t *lut = &wide_syn_lut[j * 256];
+    uint32_t term = 1; // alpha^(i k)
+    const uint32_t ai = (uint32_t)gf_alpha(i);
+    for (int k = 0; k < 8; ++k) {
+      for (int b = 1 << k; b < (2 << k); ++b)
+        lut[b] = lut[b ^ (1 << k)] ^ term;
+      term = wide_mul(term, ai);
+    }
+    wide_const_table(term, &wide_syn_step[j * 768]);
+  }
+
+  // Chien steps: term j moves by alpha^j per position
+  wide_chien.assign(t * 768, 0);
+  for (int j = 1; j <= t; ++j)
+    wide_const_table((uint32_t)gf_alpha(j), &wide_chien[(j - 1) * 768]);
+
+  // Baby-step giant-step logarithm: alpha^(q M + r) = a is found as
+  // a * alpha^(-q M) = alpha^r with r < M in the sorted baby steps.
+  const int M = 1 << ((m + 1) / 2);
+  wide_baby.resize(M);
+  uint32_t v = 1;
+  for (int r = 0; r < M; ++r) {
+    wide_baby[r] = (uint64_t)v << 32 | (uint32_t)r;
+    v = wide_mul(v, 2);
+  }
+  std::sort(wide_baby.begin(), wide_baby.end());
+  wide_giant.assign(768, 0);
+  wide_const_table((uint32_t)gf_alpha(N - M), wide_giant.data());
+}
+
+int LiteBCHCode::wide_log(uint32_t a) const {
+  if (!a)
+    return -1;
+  const int M = (int)wide_baby.size();
+  for (int q = 0; q * M < N + M; ++q) {
+    auto it =
+        std::lower_bound(wide_baby.begin(), wide_baby.end(), (uint64_t)a << 32);
+    if (it != wide_baby.end() && (uint32_t)(*it >> 32) == a)
+      return (int)(((int64_t)q * M + (uint32_t)*it) % N);
+    a = mul_const(wide_giant.data(), a);
+  }
+  return -1; // Not reached for a != 0
+}
+
+// Same contract as odd_syndromes, byte LUT only.
+void LiteBCHCode::wide_odd_syndromes(const uint8_t *p, size_t n,
+                                     int *s) const {
+  for (int j = 0; j < t; ++j) {
+    const uint32_t *lut = &wide_syn_lut[j * 256];
+    const uint32_t *step = &wide_syn_step[j * 768];
+    uint32_t v = 0;
+    for (size_t q = 0; q < n; ++q)
+      v = mul_const(step, v) ^ lut[p[q]];
+    s[2 * j + 1] = (int)v;
+  }
+}
+
+// berlekamp_massey in polynomial form: same steps, the ratio d / d_b is a
+// product with the inverse d_b^(N - 1).
+int LiteBCHCode::wide_berlekamp_massey(Workspace &ws) const {
+  const int *s = ws.s.data();
+  int *lambda = ws.lambda.data();
+  int *b = ws.bm_b.data();
+  int *prev = ws.bm_prev.data();
+
+  for (int i = 0; i <= t; i++)
+    lambda[i] = 0;
+  lambda[0] = 1;
+  b[0] = 1;
+  int L = 0, lb = 0, shift = 1;
+  uint32_t inv_db = 1;
+
+  for (int n = 0; n < 2 * t; n += 2) {
+    uint32_t d = (uint32_t)s[n + 1];
+    for (int i = 1; i <= L; i++)
+      if (lambda[i] && s[n + 1 - i])
+        d ^= wide_mul((uint32_t)lambda[i], (uint32_t)s[n + 1 - i]);
+    if (!d) {
+      shift += 2;
+      continue;
+    }
+
+    const uint32_t ratio = wide_mul(d, inv_db);
+    bool grow = 2 * L <= n;
+    if (grow) {
+      if (n + 1 - L > t)
+        return -1;
+      std::copy(lambda, lambda + L + 1, prev);
+    }
+    for (int i = 0; i <= lb; i++)
+      if (b[i])
+        lambda[i + shift] ^= (int)wide_mul(ratio, (uint32_t)b[i]);
+
+    if (grow) {
+      std::swap(b, prev);
+      lb = L;
+      L = n + 1 - L;
+      inv_db = wide_pow(d, N - 1);
+      shift = 2;
+    } else {
+      shift += 2;
+    }
+  }
+  return L;
+}
+
+// Same contract as find_roots for a polynomial-form locator. A single error
+// is a logarithm; otherwise a Chien search over the window.
+int LiteBCHCode::wide_find_roots(const int *lambda, int deg, int n_bits,
+                                 int *loc, Workspace &ws) const {
+  if (deg == 1) {
+    // lambda_1 = alpha^pos
+    int pos = wide_log((uint32_t)lambda[1]);
+    if (pos < 0 || pos >= n_bits)
+      return 0;
+    loc[0] = pos;
+    return 1;
+  }
+
+  // reg[j] = lambda_j alpha^(i j) at step i, from i = N - n_bits + 1
+  const int first = N - n_bits + 1;
+  uint32_t *r = reinterpret_cast<uint32_t *>(ws.reg.data());
+  for (int j = 1; j <= deg; ++j)
+    r[j] = lambda[j] ? wide_mul((uint32_t)lambda[j],
+                                (uint32_t)gf_alpha((int64_t)j * first))
+                     : 0;
+  int count = 0;
+  for (int i = first; i <= N && count < deg; ++i) {
+    uint32_t q = (uint32_t)lambda[0];
+    for (int j = 1; j <= deg; ++j)
+      q ^= r[j];
+    if (!q)
+      loc[count++] = N - i;
+    for (int j = 1; j <= deg; ++j)
+      r[j] = mul_const(&wide_chien[(j - 1) * 768], r[j]);
+  }
+  return count;
+}
+
+} // namespace lite
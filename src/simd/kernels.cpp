@@ -0,0 +1,103 @@
+#include "kernels.h"
+
+#include <atomic>
+
+namespace lite {
+namespace simd {
+
+const Kernels kernels_scalar = {"scalar", 0,       nullptr, nullptr, nullptr,
+                                nullptr,  nullptr, nullptr, nullptr};
+const ClmulKernel clmul_table = {"table", nullptr};
+
+const Kernels *const all_kernels[] = {&kernels_avx512, &kernels_avx2,
+                                      &kernels_ssse3,  &kernels_neon,
+                                      &kernels_wasm,   &kernels_scalar};
+const int n_kernels = sizeof(all_kernels) / sizeof(all_kernels[0]);
+const ClmulKernel *const all_clmul[] = {&clmul_pclmul, &clmul_pmull,
+                                        &clmul_table};
+const int n_clmul = sizeof(all_clmul) / sizeof(all_clmul[0]);
+
+// --- CPU Features ---
+// __builtin_cpu_supports also checks that the OS saves the AVX / AVX-512
+// register state.
+
+#if defined(LITEBCH_X86_TARGETS)
+#define LITEBCH_CPU(feature) __builtin_cpu_supports(feature)
+#else
+#define LITEBCH_CPU(feature) true // compiled in only when the flags enable it
+#endif
+
+bool cpu_has_pmull(); // kernels_pmull.cpp
+
+bool usable(const Kernels &k) {
+  if (&k == &kernels_scalar)
+    return true;
+  if (!k.chien)
+    return false;
+  if (&k == &kernels_avx512)
+    return LITEBCH_CPU("avx512bw");
+  if (&k == &kernels_avx2)
+    return LITEBCH_CPU("avx2");
+  if (&k == &kernels_ssse3)
+    return LITEBCH_CPU("ssse3");
+  return true; // NEON / WASM SIMD128: part of the compile target
+}
+
+bool usable(const ClmulKernel &k) {
+  if (&k == &clmul_table)
+    return true;
+  if (!k.encode)
+    return false;
+  if (&k == &clmul_pclmul)
+    return LITEBCH_CPU("pclmul");
+  return cpu_has_pmull();
+}
+
+// --- Binding ---
+// Null means not bound yet; the first use picks the best usable kernel.
+
+namespace {
+
+std::atomic<const Kernels *> bound_kernels(nullptr);
+std::atomic<const ClmulKernel *> bound_clmul(nullptr);
+
+template <class K> const K *best(const K *const *all, int n) {
+#if defined(LITEBCH_X86_TARGETS)
+  __builtin_cpu_init(); // in case this runs from a static initializer
+#endif
+  for (int i = 0; i < n; ++i)
+    if (usable(*all[i]))
+      return all[i];
+  return all[n - 1];
+}
+
+} // namespace
+
+const Kernels &active_kernels() {
+  const Kernels *k = bound_kernels.load(std::memory_order_acquire);
+  if (!k) {
+    k = best(all_kernels, n_kernels);
+    bound_kernels.store(k, std::memory_order_release);
+  }
+  return *k;
+}
+
+const ClmulKernel &active_clmul() {
+  const ClmulKernel *k = bound_clmul.load(std::memory_order_acquire);
+  if (!k) {
+    k = best(all_clmul, n_clmul);
+    bound_clmul.store(k, std::memory_order_release);
+  }
+  return *k;
+}
+
+void set_active_kernels(const Kernels *k) {
+  bound_kernels.store(k, std::memory_order_release);
+}
+
+void set_active_clmul(const ClmulKernel *k) {
+  bound_clmul.store(k, std::memory_order_release);
+}
+
+} // namespace simd
+} // namespace lite
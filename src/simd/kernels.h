@@ -0,0 +1,205 @@
+#ifndef LITE_SIMD_KERNELS_H
+#define LITE_SIMD_KERNELS_H
+
+// Internal SIMD kernels of LiteBCH (not installed).
+//
+// GF(2^m) elements (m <= 16) are kept in two byte planes, 'lo' (bits 0..7)
+// and 'hi' (bits 8..15). Multiplication by a constant c is linear over
+// GF(2), so x * c is the XOR of four 16-entry lookups, one per nibble of x:
+//   x * c = T0[x & 15] ^ T1[(x >> 4) & 15] ^ T2[(x >> 8) & 15] ^ T3[x >> 12]
+// with Tk[e] = (e << 4k) * c. Each table is split into a lo and a hi byte
+// table, which a byte shuffle (pshufb / tbl / swizzle) evaluates for a whole
+// vector of elements at once.
+
+#include <cstddef>
+#include <cstdint>
+
+// GCC and Clang compile the x86 kernels via target pragmas even without the
+// matching -m flags; usable() then checks the CPU before they are bound.
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+#define LITEBCH_X86_TARGETS 1
+#endif
+
+namespace lite {
+namespace simd {
+
+// Nibble tables of one constant multiplier:
+// [0..3] lo byte of Tk, [4..7] hi byte of Tk.
+struct MulTable {
+  uint8_t t[8][16];
+};
+
+// Chien search state. Term j (0-based) of the locator polynomial holds one
+// element per lane at lo[j * lanes + lane] / hi[j * lanes + lane]; one step
+// sums all terms and multiplies term j by the constant of tabs[j].
+struct ChienArgs {
+  uint8_t *lo;
+  uint8_t *hi;
+  const MulTable *tabs;
+  int n_terms;
+  bool wide; // m > 8 (hi plane in use)
+};
+
+// Runs up to 'steps' Chien steps. A lane is a root when the sum of its terms
+// equals 1. Returns the number of steps done; if the last of them found
+// roots, *mask receives their lanes (bit k = lane k), otherwise 0.
+typedef int (*ChienFn)(const ChienArgs &args, int steps, uint64_t *mask);
+
+// Syndrome tables of one syndrome S_i:
+// step: multiplier alpha^(128 i), i.e. 16 bytes of Horner.
+// in:   value of a byte at alpha^i, [0] lo / [2] hi byte for the low nibble,
+//       [1] lo / [3] hi byte for the high nibble.
+struct SyndromeTable {
+  MulTable step;
+  uint8_t in[4][16];
+};
+
+// Horner evaluation of one syndrome over interleaved byte streams. The input
+// is cut into lanes / 16 groups of 'seg' bytes starting at data + g * seg.
+// Lane k of group g evaluates bytes g * seg + 16 * b + k for b < blocks
+// (first block highest).
+struct SyndromeArgs {
+  const uint8_t *data;
+  size_t seg;
+  size_t blocks;
+  const SyndromeTable *tab;
+  bool wide;
+};
+
+// Writes the per-lane results to lo[lanes] / hi[lanes].
+typedef void (*SyndromeFn)(const SyndromeArgs &args, uint8_t *lo,
+                           uint8_t *hi);
+
+// Lockstep encoder over 'lanes' messages, one per byte lane. Message k
+// starts at data + k * stride. The MSB-aligned remainders are kept in byte
+// planes: plane b (0 = top byte of word 0) of lane k is at
+// planes[((head + b) % n_planes) * lanes + k], a ring so that shifting the
+// remainder by a byte only moves 'head'. One message byte x updates every
+// plane b with the nibble tables tabs[b] of slice 0 of the encode table:
+//   [0..15] byte b of encode_tab[e], [16..31] byte b of encode_tab[e << 4].
+struct EncodeArgs {
+  const uint8_t *data;
+  size_t stride;
+  size_t blocks; // 16-byte blocks shifted into every lane
+  const uint8_t (*tabs)[32];
+  uint8_t *planes;
+  int n_planes;
+  int head;
+};
+
+// Shifts the blocks in and returns the new head.
+typedef int (*EncodeFn)(const EncodeArgs &args);
+
+// Bit packing for the one-element-per-bit APIs, LSB first:
+// pack:   bit k of out[j] = (in[8 * j + k] != 0) for n bits; the unused bits
+//         of a partial last byte are 0.
+// unpack: out[i] = bit i % 8 of in[i / 8] (0 or 1) for n bits.
+typedef void (*PackFn)(const int32_t *in, size_t n, uint8_t *out);
+typedef void (*UnpackFn)(const uint8_t *in, size_t n, int32_t *out);
+typedef void (*Pack8Fn)(const uint8_t *in, size_t n, uint8_t *out);
+typedef void (*Unpack8Fn)(const uint8_t *in, size_t n, uint8_t *out);
+
+// Scalar versions; the SIMD ones use them for the tail.
+inline void pack_bits(const int32_t *in, size_t n, uint8_t *out) {
+  for (size_t j = 0; 8 * j < n; ++j) {
+    uint8_t b = 0;
+    for (size_t k = 0; k < 8 && 8 * j + k < n; ++k)
+      b |= (uint8_t)((in[8 * j + k] != 0) << k);
+    out[j] = b;
+  }
+}
+
+inline void pack_bits(const uint8_t *in, size_t n, uint8_t *out) {
+  for (size_t j = 0; 8 * j < n; ++j) {
+    uint8_t b = 0;
+    for (size_t k = 0; k < 8 && 8 * j + k < n; ++k)
+      b |= (uint8_t)((in[8 * j + k] != 0) << k);
+    out[j] = b;
+  }
+}
+
+inline void unpack_bits(const uint8_t *in, size_t n, int32_t *out) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = (in[i / 8] >> (i % 8)) & 1;
+}
+
+inline void unpack_bits(const uint8_t *in, size_t n, uint8_t *out) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = (in[i / 8] >> (i % 8)) & 1;
+}
+
+struct Kernels {
+  const char *name;
+  int lanes;           // Elements per Chien step, a multiple of 16
+  ChienFn chien;       // null: no SIMD Chien
+  SyndromeFn syndrome; // null: no SIMD syndromes
+  EncodeFn encode;     // null: no lockstep encoder (lanes codewords)
+  PackFn pack;         // null: pack_bits
+  UnpackFn unpack;     // null: unpack_bits
+  Pack8Fn pack8;       // null: pack_bits (uint8_t elements)
+  Unpack8Fn unpack8;   // null: unpack_bits (uint8_t elements)
+};
+
+// Carry-less multiply encoder. The remainder is handled like a CRC: it is
+// kept top-aligned in 'words' 64-bit words (word words - 1 holds the
+// highest coefficients), i.e. as remainder * x^pad modulo G = g * x^pad with
+// deg G = R = 64 * words. A step takes k = 64 or 128 message bits M:
+//   T = top k bits of s ^ M,  q = T ^ hi_k(T * mu_k)   (Barrett quotient)
+//   s = (s << k) ^ low_R(q * G)                       (without the x^R term)
+// with mu_k = floor(x^(r + k) / g) - x^k. Works for any deg g.
+struct ClmulArgs {
+  const uint64_t *g;  // G without its leading term [words]
+  const uint64_t *mu; // [0] mu_64, [1] / [2] low / high word of mu_128
+  int words;
+};
+
+// Shifts 'chunks' 8-byte message blocks (MSB first) into s[words].
+typedef void (*ClmulFn)(const ClmulArgs &args, uint64_t *s,
+                        const uint8_t *data, size_t chunks);
+
+// Message encoder: a carry-less multiply one, or the slice-by-4 tables
+// (clmul_table, encode null). encode is also null for an ISA not compiled in.
+struct ClmulKernel {
+  const char *name;
+  ClmulFn encode;
+};
+
+// Per-ISA kernel sets; a set whose ISA is not compiled in has null kernels.
+// With GCC / Clang the x86 sets are always compiled (with target pragmas),
+// so one binary carries all of them and binds what the CPU supports. NEON
+// is baseline on AArch64; WASM SIMD128 cannot be probed at run time and
+// follows -msimd128.
+extern const Kernels kernels_scalar;
+extern const Kernels kernels_ssse3;
+extern const Kernels kernels_avx2;
+extern const Kernels kernels_avx512;
+extern const Kernels kernels_neon;
+extern const Kernels kernels_wasm;
+extern const ClmulKernel clmul_pclmul; // x86-64 PCLMULQDQ
+extern const ClmulKernel clmul_pmull;  // AArch64 PMULL
+extern const ClmulKernel clmul_table;
+
+// All kernels, best first; the last one (scalar / table) is always usable.
+extern const Kernels *const all_kernels[];
+extern const int n_kernels;
+extern const ClmulKernel *const all_clmul[];
+extern const int n_clmul;
+
+// Whether the kernel is compiled in and the running CPU (and OS) supports it.
+bool usable(const Kernels &k);
+bool usable(const ClmulKernel &k);
+
+// Bound kernels: the best usable ones at first use, unless overridden.
+const Kernels &active_kernels();
+const ClmulKernel &active_clmul();
+
+// Overrides, e.g. for benchmarks; k must be usable, null goes back to the
+// automatic choice. Not safe while other threads are encoding or decoding.
+void set_active_kernels(const Kernels *k);
+void set_active_clmul(const ClmulKernel *k);
+
+} // namespace simd
+} // namespace lite
+
+#endif // LITE_SIMD_KERNELS_H
@@ -0,0 +1,153 @@
+// AVX2 kernels: 32 lanes per step (two pshufb lanes with the same tables).
+#include "kernels.h"
+
+#if defined(__AVX2__) || defined(LITEBCH_X86_TARGETS)
+#include <immintrin.h>
+#if !defined(__AVX2__) // built for the CPU check in usable()
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+#endif
+#include "kernels_impl.h"
+
+namespace lite {
+namespace simd {
+namespace {
+
+struct OpsAVX2 {
+  typedef __m256i V;
+  static const int lanes = 32;
+  static V zero() { return _mm256_setzero_si256(); }
+  static V load(const uint8_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(uint8_t *p, V v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  static V table(const uint8_t *p) {
+    return _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+  static V load_groups(const uint8_t *p, size_t seg) {
+    return _mm256_loadu2_m128i(reinterpret_cast<const __m128i *>(p + seg),
+                               reinterpret_cast<const __m128i *>(p));
+  }
+  static V shuffle(V tab, V idx) { return _mm256_shuffle_epi8(tab, idx); }
+  static V xor_(V a, V b) { return _mm256_xor_si256(a, b); }
+  static V low_nibble(V v) {
+    return _mm256_and_si256(v, _mm256_set1_epi8(0x0f));
+  }
+  static V high_nibble(V v) {
+    return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+  }
+  static V zip_lo(V a, V b) { return _mm256_unpacklo_epi8(a, b); }
+  static V zip_hi(V a, V b) { return _mm256_unpackhi_epi8(a, b); }
+  static uint64_t root_mask(V lo) {
+    return (uint32_t)_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(lo, _mm256_set1_epi8(1)));
+  }
+  static uint64_t root_mask(V lo, V hi) {
+    V eq = _mm256_and_si256(_mm256_cmpeq_epi8(lo, _mm256_set1_epi8(1)),
+                            _mm256_cmpeq_epi8(hi, _mm256_setzero_si256()));
+    return (uint32_t)_mm256_movemask_epi8(eq);
+  }
+};
+
+// 32 bits per step: narrow to bytes (saturating, so nonzero stays nonzero),
+// undo the in-lane order of the packs and take the byte mask.
+void pack(const int32_t *in, size_t n, uint8_t *out) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i *p = reinterpret_cast<const __m256i *>(in + i);
+    __m256i v = _mm256_packs_epi16(
+        _mm256_packs_epi32(_mm256_loadu_si256(p), _mm256_loadu_si256(p + 1)),
+        _mm256_packs_epi32(_mm256_loadu_si256(p + 2),
+                           _mm256_loadu_si256(p + 3)));
+    v = _mm256_permutevar8x32_epi32(v, order);
+    uint32_t m = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+    for (int k = 0; k < 4; ++k)
+      out[i / 8 + k] = (uint8_t)(m >> 8 * k);
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+// 8 bits per store: broadcast, select one bit per lane, compare.
+void unpack(const uint8_t *in, size_t n, int32_t *out) {
+  const __m256i sel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i x = _mm256_and_si256(_mm256_set1_epi32(in[i / 8]), sel);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        _mm256_srli_epi32(_mm256_cmpeq_epi32(x, sel), 31));
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+// 32 bits per load: the nonzero byte mask.
+void pack8(const uint8_t *in, size_t n, uint8_t *out) {
+  const __m256i zero = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    uint32_t m = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+    for (int k = 0; k < 4; ++k)
+      out[i / 8 + k] = (uint8_t)(m >> 8 * k);
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+// 32 bits per store: each of four bytes spread over 8 lanes (the bytes are
+// broadcast, so the in-lane pshufb reaches all of them), one bit selected
+// per lane.
+void unpack8(const uint8_t *in, size_t n, uint8_t *out) {
+  const __m256i spread = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2,
+      3, 3, 3, 3, 3, 3, 3, 3);
+  const __m256i sel = _mm256_setr_epi8(
+      1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8,
+      16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+  const __m256i one = _mm256_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const uint8_t *b = in + i / 8;
+    int w = b[0] | b[1] << 8 | b[2] << 16 | (int)((uint32_t)b[3] << 24);
+    __m256i x = _mm256_shuffle_epi8(_mm256_set1_epi32(w), spread);
+    x = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(x, sel), sel),
+                         one);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), x);
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+} // namespace
+
+const Kernels kernels_avx2 = {"avx2", OpsAVX2::lanes, &chien<OpsAVX2>,
+                              &syndrome<OpsAVX2>, &encode<OpsAVX2>,
+                              &pack, &unpack, &pack8, &unpack8};
+
+} // namespace simd
+} // namespace lite
+
+#if !defined(__AVX2__)
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif
+
+#else
+
+namespace lite {
+namespace simd {
+const Kernels kernels_avx2 = {"avx2", 32, nullptr, nullptr, nullptr,
+                              nullptr, nullptr, nullptr, nullptr};
+} // namespace simd
+} // namespace lite
+
+#endif
@@ -0,0 +1,132 @@
+// AVX-512BW kernels: 64 lanes per step.
+#include "kernels.h"
+
+#if defined(__AVX512BW__) || defined(LITEBCH_X86_TARGETS)
+#include <immintrin.h>
+#if !defined(__AVX512BW__) // built for the CPU check in usable()
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f,avx512bw"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+#endif
+#endif
+#include "kernels_impl.h"
+
+namespace lite {
+namespace simd {
+namespace {
+
+struct OpsAVX512 {
+  typedef __m512i V;
+  static const int lanes = 64;
+  static V zero() { return _mm512_setzero_si512(); }
+  static V load(const uint8_t *p) { return _mm512_loadu_si512(p); }
+  static void store(uint8_t *p, V v) { _mm512_storeu_si512(p, v); }
+  static V table(const uint8_t *p) {
+    return _mm512_maskz_broadcast_i32x4(
+        0xffff, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+  static V load_groups(const uint8_t *p, size_t seg) {
+    const __m128i *q0 = reinterpret_cast<const __m128i *>(p);
+    const __m128i *q1 = reinterpret_cast<const __m128i *>(p + seg);
+    const __m128i *q2 = reinterpret_cast<const __m128i *>(p + 2 * seg);
+    const __m128i *q3 = reinterpret_cast<const __m128i *>(p + 3 * seg);
+    // maskz forms: GCC warns about the undefined upper half of the others
+    __m512i v = _mm512_maskz_inserti64x4(0xff, _mm512_setzero_si512(),
+                                         _mm256_loadu2_m128i(q1, q0), 0);
+    return _mm512_maskz_inserti64x4(0xff, v, _mm256_loadu2_m128i(q3, q2), 1);
+  }
+  static V shuffle(V tab, V idx) { return _mm512_shuffle_epi8(tab, idx); }
+  static V xor_(V a, V b) { return _mm512_xor_si512(a, b); }
+  static V low_nibble(V v) {
+    return _mm512_and_si512(v, _mm512_set1_epi8(0x0f));
+  }
+  static V high_nibble(V v) {
+    return _mm512_and_si512(_mm512_srli_epi16(v, 4), _mm512_set1_epi8(0x0f));
+  }
+  static V zip_lo(V a, V b) { return _mm512_unpacklo_epi8(a, b); }
+  static V zip_hi(V a, V b) { return _mm512_unpackhi_epi8(a, b); }
+  static uint64_t root_mask(V lo) {
+    return _mm512_cmpeq_epi8_mask(lo, _mm512_set1_epi8(1));
+  }
+  static uint64_t root_mask(V lo, V hi) {
+    return _mm512_mask_cmpeq_epi8_mask(
+        _mm512_cmpeq_epi8_mask(lo, _mm512_set1_epi8(1)), hi,
+        _mm512_setzero_si512());
+  }
+};
+
+// 16 bits per load straight from the nonzero mask.
+void pack(const int32_t *in, size_t n, uint8_t *out) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512i v = _mm512_loadu_si512(in + i);
+    uint32_t m = _mm512_test_epi32_mask(v, v);
+    out[i / 8] = (uint8_t)m;
+    out[i / 8 + 1] = (uint8_t)(m >> 8);
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+void unpack(const uint8_t *in, size_t n, int32_t *out) {
+  const __m512i one = _mm512_set1_epi32(1);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __mmask16 m = (__mmask16)(in[i / 8] | in[i / 8 + 1] << 8);
+    _mm512_storeu_si512(out + i, _mm512_maskz_mov_epi32(m, one));
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+// 64 bits per load straight from the nonzero mask.
+void pack8(const uint8_t *in, size_t n, uint8_t *out) {
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    __m512i v = _mm512_loadu_si512(in + i);
+    uint64_t m = _mm512_test_epi8_mask(v, v);
+    for (int k = 0; k < 8; ++k)
+      out[i / 8 + k] = (uint8_t)(m >> 8 * k);
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+void unpack8(const uint8_t *in, size_t n, uint8_t *out) {
+  const __m512i one = _mm512_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    uint64_t m = 0;
+    for (int k = 0; k < 8; ++k)
+      m |= (uint64_t)in[i / 8 + k] << 8 * k;
+    _mm512_storeu_si512(out + i, _mm512_maskz_mov_epi8(m, one));
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+} // namespace
+
+const Kernels kernels_avx512 = {"avx512", OpsAVX512::lanes, &chien<OpsAVX512>,
+                                &syndrome<OpsAVX512>, &encode<OpsAVX512>,
+                                &pack, &unpack, &pack8, &unpack8};
+
+} // namespace simd
+} // namespace lite
+
+#if !defined(__AVX512BW__)
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif
+
+#else
+
+namespace lite {
+namespace simd {
+const Kernels kernels_avx512 = {"avx512", 64, nullptr, nullptr, nullptr,
+                                nullptr, nullptr, nullptr, nullptr};
+} // namespace simd
+} // namespace lite
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef LITE_SIMD_KERNELS_IMPL_H
+#define LITE_SIMD_KERNELS_IMPL_H
+
+// Generic Chien and syndrome kernels, instantiated once per ISA by the kernels_*.cpp files.
+// 'Ops' wraps one vector register type:
+//   V                      register of Ops::lanes bytes
+//   load / store           unaligned access
+//   load_groups(p, seg)    16 bytes from p + g * seg into 128-bit lane g
+//   table(p)               16-byte table broadcast to every 128-bit lane
+//   shuffle(tab, idx)      per-byte lookup, idx < 16
+//   low_nibble / high_nibble
+//   root_mask(lo[, hi])    lanes where lo == 1 (and hi == 0)
+//   zip_lo / zip_hi        interleave the low / high 8 bytes of each 128-bit
+//                          lane of two registers (punpcklbw / punpckhbw)
+
+#include "kernels.h"
+
+namespace lite {
+namespace simd {
+
+template <class Ops, bool Wide>
+int chien_steps(const ChienArgs &a, int steps, uint64_t *mask) {
+  typedef typename Ops::V V;
+  const int lanes = Ops::lanes;
+  for (int s = 0; s < steps; ++s) {
+    V acc_lo = Ops::zero();
+    V acc_hi = Ops::zero();
+    for (int j = 0; j < a.n_terms; ++j) {
+      uint8_t *plo = a.lo + j * lanes;
+      const MulTable &tab = a.tabs[j];
+
+      V lo = Ops::load(plo);
+      acc_lo = Ops::xor_(acc_lo, lo);
+      V n0 = Ops::low_nibble(lo);
+      V n1 = Ops::high_nibble(lo);
+      V r_lo = Ops::xor_(Ops::shuffle(Ops::table(tab.t[0]), n0),
+                         Ops::shuffle(Ops::table(tab.t[1]), n1));
+      if (Wide) {
+        uint8_t *phi = a.hi + j * lanes;
+        V hi = Ops::load(phi);
+        acc_hi = Ops::xor_(acc_hi, hi);
+        V n2 = Ops::low_nibble(hi);
+        V n3 = Ops::high_nibble(hi);
+        r_lo = Ops::xor_(r_lo,
+                         Ops::xor_(Ops::shuffle(Ops::table(tab.t[2]), n2),
+                                   Ops::shuffle(Ops::table(tab.t[3]), n3)));
+        V r_hi = Ops::xor_(Ops::xor_(Ops::shuffle(Ops::table(tab.t[4]), n0),
+                                     Ops::shuffle(Ops::table(tab.t[5]), n1)),
+                           Ops::xor_(Ops::shuffle(Ops::table(tab.t[6]), n2),
+                                     Ops::shuffle(Ops::table(tab.t[7]), n3)));
+        Ops::store(phi, r_hi);
+      }
+      Ops::store(plo, r_lo);
+    }
+    uint64_t m = Wide ? Ops::root_mask(acc_lo, acc_hi) : Ops::root_mask(acc_lo);
+    if (m) {
+      *mask = m;
+      return s + 1;
+    }
+  }
+  *mask = 0;
+  return steps;
+}
+
+template <class Ops> int chien(const ChienArgs &a, int steps, uint64_t *mask) {
+  return a.wide ? chien_steps<Ops, true>(a, steps, mask)
+                : chien_steps<Ops, false>(a, steps, mask);
+}
+
+template <class Ops, bool Wide>
+void syndrome_steps(const SyndromeArgs &a, uint8_t *out_lo, uint8_t *out_hi) {
+  typedef typename Ops::V V;
+  const SyndromeTable &tab = *a.tab;
+  const V st0 = Ops::table(tab.step.t[0]), st1 = Ops::table(tab.step.t[1]);
+  const V in0 = Ops::table(tab.in[0]), in1 = Ops::table(tab.in[1]);
+  V s_lo = Ops::zero();
+  V s_hi = Ops::zero();
+  if (!Wide) {
+    for (size_t b = 0; b < a.blocks; ++b) {
+      V x = Ops::load_groups(a.data + 16 * b, a.seg);
+      V r = Ops::xor_(Ops::shuffle(st0, Ops::low_nibble(s_lo)),
+                      Ops::shuffle(st1, Ops::high_nibble(s_lo)));
+      V v = Ops::xor_(Ops::shuffle(in0, Ops::low_nibble(x)),
+                      Ops::shuffle(in1, Ops::high_nibble(x)));
+      s_lo = Ops::xor_(r, v);
+    }
+  } else {
+    const V st2 = Ops::table(tab.step.t[2]), st3 = Ops::table(tab.step.t[3]);
+    const V st4 = Ops::table(tab.step.t[4]), st5 = Ops::table(tab.step.t[5]);
+    const V st6 = Ops::table(tab.step.t[6]), st7 = Ops::table(tab.step.t[7]);
+    const V in2 = Ops::table(tab.in[2]), in3 = Ops::table(tab.in[3]);
+    for (size_t b = 0; b < a.blocks; ++b) {
+      V x = Ops::load_groups(a.data + 16 * b, a.seg);
+      V x0 = Ops::low_nibble(x), x1 = Ops::high_nibble(x);
+      V n0 = Ops::low_nibble(s_lo), n1 = Ops::high_nibble(s_lo);
+      V n2 = Ops::low_nibble(s_hi), n3 = Ops::high_nibble(s_hi);
+      V r_lo = Ops::xor_(
+          Ops::xor_(Ops::shuffle(st0, n0), Ops::shuffle(st1, n1)),
+          Ops::xor_(Ops::shuffle(st2, n2), Ops::shuffle(st3, n3)));
+      V r_hi = Ops::xor_(
+          Ops::xor_(Ops::shuffle(st4, n0), Ops::shuffle(st5, n1)),
+          Ops::xor_(Ops::shuffle(st6, n2), Ops::shuffle(st7, n3)));
+      s_lo = Ops::xor_(r_lo, Ops::xor_(Ops::shuffle(in0, x0),
+                                       Ops::shuffle(in1, x1)));
+      s_hi = Ops::xor_(r_hi, Ops::xor_(Ops::shuffle(in2, x0),
+                                       Ops::shuffle(in3, x1)));
+    }
+  }
+  Ops::store(out_lo, s_lo);
+  Ops::store(out_hi, s_hi);
+}
+
+template <class Ops>
+void syndrome(const SyndromeArgs &a, uint8_t *lo, uint8_t *hi) {
+  if (a.wide)
+    syndrome_steps<Ops, true>(a, lo, hi);
+  else
+    syndrome_steps<Ops, false>(a, lo, hi);
+}
+
+// Transposes the 16 x 16 byte matrix held in each 128-bit lane of r[0..15].
+// One zip round rotates the 8-bit (row, column) index left by one, so four
+// rounds swap row and column.
+template <class Ops> void transpose16(typename Ops::V *r) {
+  typedef typename Ops::V V;
+  for (int round = 0; round < 4; ++round) {
+    V t[16];
+    for (int j = 0; j < 8; ++j) {
+      t[2 * j] = Ops::zip_lo(r[j], r[j + 8]);
+      t[2 * j + 1] = Ops::zip_hi(r[j], r[j + 8]);
+    }
+    for (int j = 0; j < 16; ++j)
+      r[j] = t[j];
+  }
+}
+
+template <class Ops> int encode(const EncodeArgs &a) {
+  typedef typename Ops::V V;
+  const int lanes = Ops::lanes;
+  const int R = a.n_planes;
+  uint8_t *planes = a.planes;
+  int head = a.head;
+  for (size_t blk = 0; blk < a.blocks; ++blk) {
+    // x[i] = byte i of the block, one message per lane
+    V x[16];
+    const uint8_t *src = a.data + 16 * blk;
+    for (int k = 0; k < 16; ++k)
+      x[k] = Ops::load_groups(src + k * a.stride, 16 * a.stride);
+    transpose16<Ops>(x);
+
+    for (int i = 0; i < 16; ++i) {
+      V fb = Ops::xor_(Ops::load(planes + head * lanes), x[i]);
+      V n0 = Ops::low_nibble(fb);
+      V n1 = Ops::high_nibble(fb);
+      // New plane b is old plane b + 1 plus the feedback term; the slot of
+      // old plane 0 becomes the last plane.
+      int q = head;
+      for (int b = 0; b < R - 1; ++b) {
+        if (++q == R)
+          q = 0;
+        uint8_t *pq = planes + q * lanes;
+        V f = Ops::xor_(Ops::shuffle(Ops::table(a.tabs[b]), n0),
+                        Ops::shuffle(Ops::table(a.tabs[b] + 16), n1));
+        Ops::store(pq, Ops::xor_(Ops::load(pq), f));
+      }
+      Ops::store(planes + head * lanes,
+                 Ops::xor_(Ops::shuffle(Ops::table(a.tabs[R - 1]), n0),
+                           Ops::shuffle(Ops::table(a.tabs[R - 1] + 16), n1)));
+      if (++head == R)
+        head = 0;
+    }
+  }
+  return head;
+}
+
+} // namespace simd
+} // namespace lite
+
+#endif // LITE_SIMD_KERNELS_IMPL_H
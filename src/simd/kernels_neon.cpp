@@ -0,0 +1,134 @@
+// AArch64 NEON kernels: 16 lanes per step (tbl).
+#include "kernels.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include "kernels_impl.h"
+#include <arm_neon.h>
+
+namespace lite {
+namespace simd {
+namespace {
+
+struct OpsNEON {
+  typedef uint8x16_t V;
+  static const int lanes = 16;
+  static V zero() { return vdupq_n_u8(0); }
+  static V load(const uint8_t *p) { return vld1q_u8(p); }
+  static void store(uint8_t *p, V v) { vst1q_u8(p, v); }
+  static V table(const uint8_t *p) { return vld1q_u8(p); }
+  static V load_groups(const uint8_t *p, size_t) { return vld1q_u8(p); }
+  static V shuffle(V tab, V idx) { return vqtbl1q_u8(tab, idx); }
+  static V xor_(V a, V b) { return veorq_u8(a, b); }
+  static V low_nibble(V v) { return vandq_u8(v, vdupq_n_u8(0x0f)); }
+  static V high_nibble(V v) { return vshrq_n_u8(v, 4); }
+  static V zip_lo(V a, V b) { return vzip1q_u8(a, b); }
+  static V zip_hi(V a, V b) { return vzip2q_u8(a, b); }
+  // No movemask on NEON; roots are rare, so test first and extract slowly.
+  static uint64_t to_mask(V eq) {
+    if (vmaxvq_u8(eq) == 0)
+      return 0;
+    uint8_t b[16];
+    vst1q_u8(b, eq);
+    uint64_t m = 0;
+    for (int k = 0; k < 16; ++k)
+      if (b[k])
+        m |= 1ULL << k;
+    return m;
+  }
+  static uint64_t root_mask(V lo) { return to_mask(vceqq_u8(lo, vdupq_n_u8(1))); }
+  static uint64_t root_mask(V lo, V hi) {
+    return to_mask(vandq_u8(vceqq_u8(lo, vdupq_n_u8(1)),
+                            vceqq_u8(hi, vdupq_n_u8(0))));
+  }
+};
+
+// 16 bits per step: nonzero masks narrowed to bytes, weighted by their bit
+// and summed per half.
+void pack(const int32_t *in, size_t n, uint8_t *out) {
+  static const uint8_t w[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t weights = vld1q_u8(w);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const uint32_t *p = reinterpret_cast<const uint32_t *>(in + i);
+    uint32x4_t a = vld1q_u32(p), b = vld1q_u32(p + 4);
+    uint32x4_t c = vld1q_u32(p + 8), d = vld1q_u32(p + 12);
+    uint16x8_t ab = vcombine_u16(vmovn_u32(vtstq_u32(a, a)),
+                                 vmovn_u32(vtstq_u32(b, b)));
+    uint16x8_t cd = vcombine_u16(vmovn_u32(vtstq_u32(c, c)),
+                                 vmovn_u32(vtstq_u32(d, d)));
+    uint8x16_t v = vandq_u8(vcombine_u8(vmovn_u16(ab), vmovn_u16(cd)),
+                            weights);
+    out[i / 8] = vaddv_u8(vget_low_u8(v));
+    out[i / 8 + 1] = vaddv_u8(vget_high_u8(v));
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+// 16 bits per step: broadcast each byte over 8 lanes, test, widen.
+void unpack(const uint8_t *in, size_t n, int32_t *out) {
+  static const uint8_t w[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t weights = vld1q_u8(w);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint8x16_t b =
+        vcombine_u8(vdup_n_u8(in[i / 8]), vdup_n_u8(in[i / 8 + 1]));
+    uint8x16_t x = vandq_u8(vtstq_u8(b, weights), vdupq_n_u8(1));
+    uint16x8_t lo = vmovl_u8(vget_low_u8(x)), hi = vmovl_u8(vget_high_u8(x));
+    uint32_t *q = reinterpret_cast<uint32_t *>(out + i);
+    vst1q_u32(q, vmovl_u16(vget_low_u16(lo)));
+    vst1q_u32(q + 4, vmovl_u16(vget_high_u16(lo)));
+    vst1q_u32(q + 8, vmovl_u16(vget_low_u16(hi)));
+    vst1q_u32(q + 12, vmovl_u16(vget_high_u16(hi)));
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+// 16 bits per step: nonzero masks weighted by their bit, summed per half.
+void pack8(const uint8_t *in, size_t n, uint8_t *out) {
+  static const uint8_t w[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t weights = vld1q_u8(w);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint8x16_t v = vld1q_u8(in + i);
+    v = vandq_u8(vtstq_u8(v, v), weights);
+    out[i / 8] = vaddv_u8(vget_low_u8(v));
+    out[i / 8 + 1] = vaddv_u8(vget_high_u8(v));
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+void unpack8(const uint8_t *in, size_t n, uint8_t *out) {
+  static const uint8_t w[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t weights = vld1q_u8(w);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint8x16_t b =
+        vcombine_u8(vdup_n_u8(in[i / 8]), vdup_n_u8(in[i / 8 + 1]));
+    vst1q_u8(out + i, vandq_u8(vtstq_u8(b, weights), vdupq_n_u8(1)));
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+} // namespace
+
+const Kernels kernels_neon = {"neon", OpsNEON::lanes, &chien<OpsNEON>,
+                              &syndrome<OpsNEON>, &encode<OpsNEON>,
+                              &pack, &unpack, &pack8, &unpack8};
+
+} // namespace simd
+} // namespace lite
+
+#else
+
+namespace lite {
+namespace simd {
+const Kernels kernels_neon = {"neon", 16, nullptr, nullptr, nullptr,
+                              nullptr, nullptr, nullptr, nullptr};
+} // namespace simd
+} // namespace lite
+
+#endif
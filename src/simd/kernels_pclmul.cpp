@@ -0,0 +1,92 @@
+// x86-64 PCLMULQDQ encoder (see ClmulArgs). Built with a target attribute
+// and bound after a CPU check (see usable()), so it needs no -m flags.
+#include "kernels.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cstring>
+#include <immintrin.h>
+
+#define LITEBCH_PCLMUL __attribute__((target("pclmul")))
+
+namespace lite {
+namespace simd {
+namespace {
+
+LITEBCH_PCLMUL inline __m128i clmul(uint64_t a, uint64_t b) {
+  return _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a),
+                              _mm_cvtsi64_si128((long long)b), 0x00);
+}
+inline uint64_t lo64(__m128i v) { return (uint64_t)_mm_cvtsi128_si64(v); }
+inline uint64_t hi64(__m128i v) {
+  return (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(v, v));
+}
+
+inline uint64_t load_be64(const uint8_t *p) {
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+  return __builtin_bswap64(v);
+}
+
+LITEBCH_PCLMUL void shift_in(const ClmulArgs &a, uint64_t *s,
+                             const uint8_t *data, size_t chunks) {
+  const int W = a.words;
+  const uint64_t *g = a.g;
+  size_t i = 0;
+
+  // 128 bits per step: T = t1 * x^64 + t0, q = q1 * x^64 + q0
+  for (; i + 2 <= chunks; i += 2) {
+    uint64_t t1 = s[W - 1] ^ load_be64(data + 8 * i);
+    uint64_t t0 = (W > 1 ? s[W - 2] : 0) ^ load_be64(data + 8 * i + 8);
+    __m128i h = clmul(t1, a.mu[2]);
+    uint64_t q1 = t1 ^ hi64(h);
+    uint64_t q0 = t0 ^ lo64(h) ^ hi64(clmul(t1, a.mu[1])) ^
+                  hi64(clmul(t0, a.mu[2]));
+    // New word w: old word w - 2, plus q0 * g[w] / g[w - 1] and
+    // q1 * g[w - 1] / g[w - 2]. Top down, so old words are read first.
+    __m128i p0 = clmul(q0, g[W - 1]);
+    __m128i p1 = W > 1 ? clmul(q1, g[W - 2]) : _mm_setzero_si128();
+    for (int w = W - 1; w >= 2; --w) {
+      __m128i p0m = clmul(q0, g[w - 1]);
+      __m128i p1m = clmul(q1, g[w - 2]);
+      s[w] = s[w - 2] ^ lo64(p0) ^ hi64(p0m) ^ lo64(p1) ^ hi64(p1m);
+      p0 = p0m;
+      p1 = p1m;
+    }
+    if (W > 1) {
+      __m128i p0m = clmul(q0, g[0]);
+      s[1] = lo64(p0) ^ hi64(p0m) ^ lo64(p1);
+      p0 = p0m;
+    }
+    s[0] = lo64(p0);
+  }
+
+  // 64 bits per step
+  for (; i < chunks; ++i) {
+    uint64_t f = s[W - 1] ^ load_be64(data + 8 * i);
+    uint64_t q = f ^ hi64(clmul(f, a.mu[0]));
+    __m128i p = clmul(q, g[W - 1]);
+    for (int w = W - 1; w > 0; --w) {
+      __m128i pm = clmul(q, g[w - 1]);
+      s[w] = s[w - 1] ^ lo64(p) ^ hi64(pm);
+      p = pm;
+    }
+    s[0] = lo64(p);
+  }
+}
+
+} // namespace
+
+const ClmulKernel clmul_pclmul = {"pclmul", &shift_in};
+
+} // namespace simd
+} // namespace lite
+
+#else
+
+namespace lite {
+namespace simd {
+const ClmulKernel clmul_pclmul = {"pclmul", nullptr};
+} // namespace simd
+} // namespace lite
+
+#endif
@@ -0,0 +1,110 @@
+// AArch64 PMULL encoder (see ClmulArgs). Built with a target attribute and
+// picked by a hardware capability check, so it needs no -march flags.
+#include "kernels.h"
+
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__)) &&      \
+    defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_neon.h>
+#include <cstring>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_PMULL
+#define HWCAP_PMULL (1 << 4)
+#endif
+#endif
+
+#if defined(__clang__)
+#define LITEBCH_PMULL __attribute__((target("aes")))
+#else
+#define LITEBCH_PMULL __attribute__((target("+crypto")))
+#endif
+
+namespace lite {
+namespace simd {
+namespace {
+
+LITEBCH_PMULL inline uint64x2_t clmul(uint64_t a, uint64_t b) {
+  return vreinterpretq_u64_p128(vmull_p64((poly64_t)a, (poly64_t)b));
+}
+inline uint64_t lo64(uint64x2_t v) { return vgetq_lane_u64(v, 0); }
+inline uint64_t hi64(uint64x2_t v) { return vgetq_lane_u64(v, 1); }
+
+inline uint64_t load_be64(const uint8_t *p) {
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+  return __builtin_bswap64(v);
+}
+
+// Same steps and word updates as the PCLMULQDQ kernel
+LITEBCH_PMULL void shift_in(const ClmulArgs &a, uint64_t *s,
+                            const uint8_t *data, size_t chunks) {
+  const int W = a.words;
+  const uint64_t *g = a.g;
+  size_t i = 0;
+
+  for (; i + 2 <= chunks; i += 2) {
+    uint64_t t1 = s[W - 1] ^ load_be64(data + 8 * i);
+    uint64_t t0 = (W > 1 ? s[W - 2] : 0) ^ load_be64(data + 8 * i + 8);
+    uint64x2_t h = clmul(t1, a.mu[2]);
+    uint64_t q1 = t1 ^ hi64(h);
+    uint64_t q0 = t0 ^ lo64(h) ^ hi64(clmul(t1, a.mu[1])) ^
+                  hi64(clmul(t0, a.mu[2]));
+    uint64x2_t p0 = clmul(q0, g[W - 1]);
+    uint64x2_t p1 = W > 1 ? clmul(q1, g[W - 2]) : vdupq_n_u64(0);
+    for (int w = W - 1; w >= 2; --w) {
+      uint64x2_t p0m = clmul(q0, g[w - 1]);
+      uint64x2_t p1m = clmul(q1, g[w - 2]);
+      s[w] = s[w - 2] ^ lo64(p0) ^ hi64(p0m) ^ lo64(p1) ^ hi64(p1m);
+      p0 = p0m;
+      p1 = p1m;
+    }
+    if (W > 1) {
+      uint64x2_t p0m = clmul(q0, g[0]);
+      s[1] = lo64(p0) ^ hi64(p0m) ^ lo64(p1);
+      p0 = p0m;
+    }
+    s[0] = lo64(p0);
+  }
+
+  for (; i < chunks; ++i) {
+    uint64_t f = s[W - 1] ^ load_be64(data + 8 * i);
+    uint64_t q = f ^ hi64(clmul(f, a.mu[0]));
+    uint64x2_t p = clmul(q, g[W - 1]);
+    for (int w = W - 1; w > 0; --w) {
+      uint64x2_t pm = clmul(q, g[w - 1]);
+      s[w] = s[w - 1] ^ lo64(p) ^ hi64(pm);
+      p = pm;
+    }
+    s[0] = lo64(p);
+  }
+}
+
+} // namespace
+
+const ClmulKernel clmul_pmull = {"pmull", &shift_in};
+
+bool cpu_has_pmull() {
+#if defined(__APPLE__)
+  return true; // Every Apple AArch64 core has the crypto extension
+#elif defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+#elif defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace simd
+} // namespace lite
+
+#else
+
+namespace lite {
+namespace simd {
+const ClmulKernel clmul_pmull = {"pmull", nullptr};
+bool cpu_has_pmull() { return false; }
+} // namespace simd
+} // namespace lite
+
+#endif
@@ -0,0 +1,138 @@
+// SSSE3 kernels: 16 lanes per step (pshufb).
+#include "kernels.h"
+
+#if defined(__SSSE3__) || defined(LITEBCH_X86_TARGETS)
+#include <tmmintrin.h>
+#if !defined(__SSSE3__) // built for the CPU check in usable()
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("ssse3"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("ssse3")
+#endif
+#endif
+#include "kernels_impl.h"
+
+namespace lite {
+namespace simd {
+namespace {
+
+struct OpsSSSE3 {
+  typedef __m128i V;
+  static const int lanes = 16;
+  static V zero() { return _mm_setzero_si128(); }
+  static V load(const uint8_t *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static void store(uint8_t *p, V v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+  }
+  static V table(const uint8_t *p) { return load(p); }
+  static V load_groups(const uint8_t *p, size_t) { return load(p); }
+  static V shuffle(V tab, V idx) { return _mm_shuffle_epi8(tab, idx); }
+  static V xor_(V a, V b) { return _mm_xor_si128(a, b); }
+  static V low_nibble(V v) { return _mm_and_si128(v, _mm_set1_epi8(0x0f)); }
+  static V high_nibble(V v) {
+    return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+  }
+  static V zip_lo(V a, V b) { return _mm_unpacklo_epi8(a, b); }
+  static V zip_hi(V a, V b) { return _mm_unpackhi_epi8(a, b); }
+  static uint64_t root_mask(V lo) {
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(lo, _mm_set1_epi8(1)));
+  }
+  static uint64_t root_mask(V lo, V hi) {
+    V eq = _mm_and_si128(_mm_cmpeq_epi8(lo, _mm_set1_epi8(1)),
+                         _mm_cmpeq_epi8(hi, _mm_setzero_si128()));
+    return (uint32_t)_mm_movemask_epi8(eq);
+  }
+};
+
+// 16 bits per step: narrow to bytes (saturating, so nonzero stays nonzero)
+// and take the byte mask.
+void pack(const int32_t *in, size_t n, uint8_t *out) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i *p = reinterpret_cast<const __m128i *>(in + i);
+    __m128i v = _mm_packs_epi16(
+        _mm_packs_epi32(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)),
+        _mm_packs_epi32(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3)));
+    uint32_t m = ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+    out[i / 8] = (uint8_t)m;
+    out[i / 8 + 1] = (uint8_t)(m >> 8);
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+// 4 bits per store: broadcast, select one bit per lane, compare.
+void unpack(const uint8_t *in, size_t n, int32_t *out) {
+  const __m128i sel = _mm_set_epi32(8, 4, 2, 1);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    for (int h = 0; h < 2; ++h) {
+      __m128i x = _mm_and_si128(_mm_set1_epi32(in[i / 8] >> (4 * h)), sel);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 4 * h),
+                       _mm_srli_epi32(_mm_cmpeq_epi32(x, sel), 31));
+    }
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+// 16 bits per load: the nonzero byte mask.
+void pack8(const uint8_t *in, size_t n, uint8_t *out) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    uint32_t m = ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+    out[i / 8] = (uint8_t)m;
+    out[i / 8 + 1] = (uint8_t)(m >> 8);
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+// 16 bits per store: each of two bytes spread over 8 lanes (pshufb), one
+// bit selected per lane.
+void unpack8(const uint8_t *in, size_t n, uint8_t *out) {
+  const __m128i spread =
+      _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+  const __m128i sel = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8,
+                                    16, 32, 64, -128);
+  const __m128i one = _mm_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_shuffle_epi8(
+        _mm_cvtsi32_si128(in[i / 8] | in[i / 8 + 1] << 8), spread);
+    x = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(x, sel), sel), one);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), x);
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+} // namespace
+
+const Kernels kernels_ssse3 = {"ssse3", OpsSSSE3::lanes, &chien<OpsSSSE3>,
+                               &syndrome<OpsSSSE3>, &encode<OpsSSSE3>,
+                               &pack, &unpack, &pack8, &unpack8};
+
+} // namespace simd
+} // namespace lite
+
+#if !defined(__SSSE3__)
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif
+
+#else
+
+namespace lite {
+namespace simd {
+const Kernels kernels_ssse3 = {"ssse3", 16, nullptr, nullptr, nullptr,
+                               nullptr, nullptr, nullptr, nullptr};
+} // namespace simd
+} // namespace lite
+
+#endif
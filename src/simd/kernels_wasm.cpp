@@ -0,0 +1,124 @@
+// WebAssembly SIMD128 kernels: 16 lanes per step (i8x16.swizzle).
+#include "kernels.h"
+
+#if defined(__wasm_simd128__)
+#include "kernels_impl.h"
+#include <wasm_simd128.h>
+
+namespace lite {
+namespace simd {
+namespace {
+
+struct OpsWasm {
+  typedef v128_t V;
+  static const int lanes = 16;
+  static V zero() { return wasm_i8x16_splat(0); }
+  static V load(const uint8_t *p) { return wasm_v128_load(p); }
+  static void store(uint8_t *p, V v) { wasm_v128_store(p, v); }
+  static V table(const uint8_t *p) { return wasm_v128_load(p); }
+  static V load_groups(const uint8_t *p, size_t) { return wasm_v128_load(p); }
+  static V shuffle(V tab, V idx) { return wasm_i8x16_swizzle(tab, idx); }
+  static V xor_(V a, V b) { return wasm_v128_xor(a, b); }
+  static V low_nibble(V v) { return wasm_v128_and(v, wasm_i8x16_splat(0x0f)); }
+  static V high_nibble(V v) { return wasm_u8x16_shr(v, 4); }
+  static V zip_lo(V a, V b) {
+    return wasm_i8x16_shuffle(a, b, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21,
+                              6, 22, 7, 23);
+  }
+  static V zip_hi(V a, V b) {
+    return wasm_i8x16_shuffle(a, b, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13,
+                              29, 14, 30, 15, 31);
+  }
+  static uint64_t root_mask(V lo) {
+    return wasm_i8x16_bitmask(wasm_i8x16_eq(lo, wasm_i8x16_splat(1)));
+  }
+  static uint64_t root_mask(V lo, V hi) {
+    return wasm_i8x16_bitmask(
+        wasm_v128_and(wasm_i8x16_eq(lo, wasm_i8x16_splat(1)),
+                      wasm_i8x16_eq(hi, wasm_i8x16_splat(0))));
+  }
+};
+
+// 16 bits per step: nonzero masks narrowed to bytes, then the byte mask.
+void pack(const int32_t *in, size_t n, uint8_t *out) {
+  const v128_t zero = wasm_i32x4_splat(0);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const int32_t *p = in + i;
+    v128_t ab = wasm_i16x8_narrow_i32x4(
+        wasm_i32x4_ne(wasm_v128_load(p), zero),
+        wasm_i32x4_ne(wasm_v128_load(p + 4), zero));
+    v128_t cd = wasm_i16x8_narrow_i32x4(
+        wasm_i32x4_ne(wasm_v128_load(p + 8), zero),
+        wasm_i32x4_ne(wasm_v128_load(p + 12), zero));
+    uint32_t m = wasm_i8x16_bitmask(wasm_i8x16_narrow_i16x8(ab, cd));
+    out[i / 8] = (uint8_t)m;
+    out[i / 8 + 1] = (uint8_t)(m >> 8);
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+// 4 bits per store: broadcast, select one bit per lane, compare.
+void unpack(const uint8_t *in, size_t n, int32_t *out) {
+  const v128_t sel = wasm_i32x4_make(1, 2, 4, 8);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    for (int h = 0; h < 2; ++h) {
+      v128_t x = wasm_v128_and(wasm_i32x4_splat(in[i / 8] >> (4 * h)), sel);
+      wasm_v128_store(out + i + 4 * h,
+                      wasm_u32x4_shr(wasm_i32x4_eq(x, sel), 31));
+    }
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+// 16 bits per load: the nonzero byte mask.
+void pack8(const uint8_t *in, size_t n, uint8_t *out) {
+  const v128_t zero = wasm_i8x16_splat(0);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint32_t m =
+        wasm_i8x16_bitmask(wasm_i8x16_ne(wasm_v128_load(in + i), zero));
+    out[i / 8] = (uint8_t)m;
+    out[i / 8 + 1] = (uint8_t)(m >> 8);
+  }
+  pack_bits(in + i, n - i, out + i / 8);
+}
+
+// 16 bits per store: each of two bytes spread over 8 lanes (swizzle), one
+// bit selected per lane.
+void unpack8(const uint8_t *in, size_t n, uint8_t *out) {
+  const v128_t spread =
+      wasm_i8x16_make(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+  const v128_t sel = wasm_i8x16_make(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4,
+                                     8, 16, 32, 64, -128);
+  const v128_t one = wasm_i8x16_splat(1);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    v128_t x = wasm_i8x16_swizzle(
+        wasm_i16x8_splat((int16_t)(in[i / 8] | in[i / 8 + 1] << 8)), spread);
+    x = wasm_v128_and(wasm_i8x16_eq(wasm_v128_and(x, sel), sel), one);
+    wasm_v128_store(out + i, x);
+  }
+  unpack_bits(in + i / 8, n - i, out + i);
+}
+
+} // namespace
+
+const Kernels kernels_wasm = {"wasm-simd128", OpsWasm::lanes, &chien<OpsWasm>,
+                              &syndrome<OpsWasm>, &encode<OpsWasm>,
+                              &pack, &unpack, &pack8, &unpack8};
+
+} // namespace simd
+} // namespace lite
+
+#else
+
+namespace lite {
+namespace simd {
+const Kernels kernels_wasm = {"wasm-simd128", 16, nullptr, nullptr, nullptr,
+                              nullptr, nullptr, nullptr, nullptr};
+} // namespace simd
+} // namespace lite
+
+#endif
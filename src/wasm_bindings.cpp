@@ -1,5 +1,10 @@
+#include <algorithm>
 #include <emscripten/bind.h>
 #include <litebch/LiteBCH.h>
+#include <litebch/ParallelBCH.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 using namespace emscripten;
@@ -8,15 +13,50 @@ using namespace emscripten;
 // LiteBCH uses std::vector<int> for messages and encoded data.
 // We need to register std::vector<int> so JS can use it.
 
-// Helper to expose Byte-Wise Encode to JS via Vector Interface
-void encode_bytes_wrapper(lite::LiteBCH &bch, val data_qs, int len,
-                          val ecc_qs) {
-  // Placeholder for direct memory binding if needed.
-  // Currently unused as we rely on encode_fast_wrapper via vectors.
+// --- Uint8Array Helpers ---
+// Copy between JS typed arrays and wasm memory through heap views.
+
+std::vector<uint8_t> from_js(const val &array) {
+  std::vector<uint8_t> buf(array["length"].as<size_t>());
+  val(typed_memory_view(buf.size(), buf.data())).call<void>("set", array);
+  return buf;
+}
+
+void to_js(val &array, const std::vector<uint8_t> &buf) {
+  array.call<void>("set", val(typed_memory_view(buf.size(), buf.data())));
+}
+
+// Byte-wise encode of a Uint8Array; returns the ECC as a new Uint8Array.
+// Copies the data once; use encode_raw_ptr to avoid that.
+val encode_bytes_wrapper(lite::LiteBCH &bch, val data) {
+  std::vector<uint8_t> msg = from_js(data);
+  std::vector<uint8_t> ecc(bch.get_ecc_bytes());
+  bch.encode(msg.data(), msg.size(), ecc.data());
+  return val::global("Uint8Array")
+      .new_(typed_memory_view(ecc.size(), ecc.data()));
+}
+
+// Byte-wise decode; corrects both Uint8Arrays in place.
+// Returns the number of corrected errors, or -1 if uncorrectable.
+int decode_bytes_wrapper(lite::LiteBCH &bch, val data, val ecc) {
+  std::vector<uint8_t> msg = from_js(data);
+  std::vector<uint8_t> par = from_js(ecc);
+  if (par.size() < (size_t)bch.get_ecc_bytes()) {
+    throw std::invalid_argument("ECC size must be ecc_bytes");
+  }
+  int count = bch.decode(msg.data(), msg.size(), par.data());
+  if (count > 0) {
+    to_js(data, msg);
+    to_js(ecc, par);
+  }
+  return count;
 }
 
-// Expose 'encode' taking integer memory addresses (pointers) to avoid copies.
-// JS side must manage memory (alloc/free) and pass aligned pointers.
+// --- Raw Pointers ---
+// Expose the byte API taking integer memory addresses (pointers) to avoid
+// copies. JS side must manage memory (Module._malloc/_free) and pass
+// pointers into HEAPU8. Lengths, strides and layouts are as in LiteBCHCode.
+
 void encode_raw_ptrs(lite::LiteBCH &bch, uintptr_t data_ptr, int len,
                      uintptr_t ecc_ptr) {
   uint8_t *data = reinterpret_cast<uint8_t *>(data_ptr);
@@ -24,6 +64,96 @@ void encode_raw_ptrs(lite::LiteBCH &bch, uintptr_t data_ptr, int len,
   bch.encode(data, len, ecc);
 }
 
+// Corrects data and ECC in place; returns the error count or -1.
+int decode_raw_ptrs(lite::LiteBCH &bch, uintptr_t data_ptr, int len,
+                    uintptr_t ecc_ptr) {
+  uint8_t *data = reinterpret_cast<uint8_t *>(data_ptr);
+  uint8_t *ecc = reinterpret_cast<uint8_t *>(ecc_ptr);
+  return bch.decode(data, len, ecc);
+}
+
+bool check_raw_ptrs(lite::LiteBCH &bch, uintptr_t data_ptr, int len,
+                    uintptr_t ecc_ptr) {
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(data_ptr);
+  const uint8_t *ecc = reinterpret_cast<const uint8_t *>(ecc_ptr);
+  return bch.check(data, len, ecc);
+}
+
+void encode_batch_raw_ptrs(lite::LiteBCH &bch, uintptr_t data_ptr, int len,
+                           int stride, int count, uintptr_t ecc_ptr,
+                           int ecc_stride) {
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(data_ptr);
+  uint8_t *ecc = reinterpret_cast<uint8_t *>(ecc_ptr);
+  bch.encode_batch(data, len, stride, count, ecc, ecc_stride);
+}
+
+// Per-codeword results (errors corrected, or -1) as a new Int32Array.
+val errors_array(const std::vector<int> &errors) {
+  return val::global("Int32Array")
+      .new_(typed_memory_view(errors.size(), errors.data()));
+}
+
+val decode_batch_raw_ptrs(lite::LiteBCH &bch, uintptr_t data_ptr, int len,
+                          int stride, int count, uintptr_t ecc_ptr,
+                          int ecc_stride) {
+  uint8_t *data = reinterpret_cast<uint8_t *>(data_ptr);
+  uint8_t *ecc = reinterpret_cast<uint8_t *>(ecc_ptr);
+  std::vector<int> errors(count);
+  bch.decode_batch(data, len, stride, count, ecc, ecc_stride, errors.data());
+  return errors_array(errors);
+}
+
+// --- Parallel Batches ---
+// In a -pthread build (LITEBCH_WASM_THREADS, needs SharedArrayBuffer) the
+// pool workers are Web Workers from the Emscripten thread pool. The caller
+// joins in and blocks until the batch is done, so drive it from a Worker,
+// not the page's main thread. Without -pthread it runs on the caller only.
+// The pool is pre-started with one Worker per core, and a thread beyond it
+// would wait for the event loop this caller blocks, so 'threads' (0 = all)
+// is clamped to the core count.
+lite::ParallelBCH *create_parallel(lite::LiteBCH &bch, unsigned threads) {
+#if defined(__EMSCRIPTEN_PTHREADS__)
+  const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  if (threads == 0 || threads > cores)
+    threads = cores;
+#else
+  threads = 1;
+#endif
+  return new lite::ParallelBCH(bch.get_code(), threads);
+}
+
+void parallel_encode_batch(lite::ParallelBCH &par, uintptr_t data_ptr,
+                           int len, int stride, int count, uintptr_t ecc_ptr,
+                           int ecc_stride) {
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(data_ptr);
+  uint8_t *ecc = reinterpret_cast<uint8_t *>(ecc_ptr);
+  par.encode_batch(data, len, stride, count, ecc, ecc_stride);
+}
+
+val parallel_decode_batch(lite::ParallelBCH &par, uintptr_t data_ptr,
+                          int len, int stride, int count, uintptr_t ecc_ptr,
+                          int ecc_stride) {
+  uint8_t *data = reinterpret_cast<uint8_t *>(data_ptr);
+  uint8_t *ecc = reinterpret_cast<uint8_t *>(ecc_ptr);
+  std::vector<int> errors(count);
+  par.decode_batch(data, len, stride, count, ecc, ecc_stride, errors.data());
+  return errors_array(errors);
+}
+
+// Bytes held by the code's tables and by the default Workspace (see
+// LiteBCHCode::memory_usage), for tests/wasm_scalability_test.js
+size_t table_bytes(const lite::LiteBCH &bch) {
+  lite::LiteBCHCode::MemoryUsage usage = bch.memory_usage();
+  return usage.gf + usage.encoder + usage.decoder;
+}
+
+size_t workspace_bytes(const lite::LiteBCH &bch) {
+  return bch.memory_usage().workspace;
+}
+
+// Kernel set in use: "wasm-simd128" when built with -msimd128.
+std::string vector_backend() { return lite::get_vector_backend(); }
+
 // Factory for debug
 lite::LiteBCH *create_litebch_custom(int N, int t, const std::vector<int> &p) {
   try {
@@ -33,53 +163,28 @@ lite::LiteBCH *create_litebch_custom(int N, int t, const std::vector<int> &p) {
   }
 }
 
+// Table blobs for instant cold start: serialize once, keep the Uint8Array
+// (e.g. in IndexedDB or as a static asset) and build later pages from it.
+val serialize_tables(lite::LiteBCH &bch) {
+  std::vector<uint8_t> blob = bch.get_code()->serialize();
+  return val::global("Uint8Array")
+      .new_(typed_memory_view(blob.size(), blob.data()));
+}
+
+lite::LiteBCH *create_litebch_from_tables(const std::string &blob) {
+  return new lite::LiteBCH(lite::LiteBCHCode::deserialize(
+      reinterpret_cast<const uint8_t *>(blob.data()), blob.size()));
+}
+
 // Wrapper for Fast Encoding (Bit-Vector Interface)
-// Adapts the byte-oriented fast encoder to the bit-oriented JS interface
+// Kept for existing JS callers; encode() is just as fast now.
 std::vector<int> encode_fast_wrapper(lite::LiteBCH &bch,
                                      const std::vector<int> &msg_bits) {
-  int K = bch.get_K();
-  int N = bch.get_N();
-  int ecc_bytes = bch.get_ecc_bytes();
-  int n_rdncy = N - K;
-
-  if (msg_bits.size() != (size_t)K) {
+  if (msg_bits.size() != (size_t)bch.get_K()) {
     throw std::invalid_argument("Message size must be K");
   }
-
-  // 1. Pack Bits to Bytes (MSB First)
-  // Matching LiteBCH::decode logic
-  std::vector<uint8_t> data((K + 7) / 8, 0);
-  for (int i = 0; i < K; ++i) {
-    // Message bits are packed such that index 0 is high degree.
-    int stream_pos = K - 1 - i;
-    if (msg_bits[i]) {
-      data[stream_pos / 8] |= (1 << (7 - (stream_pos % 8)));
-    }
-  }
-
-  // 2. Run Fast Encode
-  std::vector<uint8_t> ecc(ecc_bytes);
-  bch.encode(data.data(), data.size(), ecc.data());
-
-  // 3. Unpack ECC to Bits and Construct Codeword [Parity | Message]
-  std::vector<int> codeword(N);
-
-  // Parity (ECC)
-  // decode() expects ecc bits at indices 0..n_rdncy-1
-  // and packs them: ecc[i/8] |= (1 << (i%8)) -> LSB packing for ECC!
-  for (int i = 0; i < n_rdncy; ++i) {
-    if ((ecc[i / 8] >> (i % 8)) & 1) {
-      codeword[i] = 1;
-    } else {
-      codeword[i] = 0;
-    }
-  }
-
-  // Message
-  for (int i = 0; i < K; ++i) {
-    codeword[n_rdncy + i] = msg_bits[i];
-  }
-
+  std::vector<int> codeword(bch.get_N());
+  bch.encode_bits(msg_bits.data(), codeword.data());
   return codeword;
 }
 
@@ -90,11 +195,13 @@ EMSCRIPTEN_BINDINGS(litebch_module) {
       .constructor<int, int>()
       // Use factory for custom poly
       .constructor(&create_litebch_custom, allow_raw_pointers())
+      // From a serialize_tables() blob (Uint8Array)
+      .constructor(&create_litebch_from_tables, allow_raw_pointers())
       .function("get_K", &lite::LiteBCH::get_K)
       .function("get_N", &lite::LiteBCH::get_N) // Exposure needed
       .function("get_t", &lite::LiteBCH::get_t) // Exposure needed
 
-      // Legacy Encode
+      // Bit-Vector Encode (byte engine)
       .function("encode",
                 static_cast<std::vector<int> (lite::LiteBCH::*)(
                     const std::vector<int> &)>(&lite::LiteBCH::encode))
@@ -102,13 +209,35 @@ EMSCRIPTEN_BINDINGS(litebch_module) {
       // Fast Encode Wrapper
       .function("encode_fast", &encode_fast_wrapper)
 
-      // Raw Byte Buffer Encode (High Perf)
+      // Raw Byte Buffers (High Perf)
       // JS must manage memory (alloc/free) and pass pointers.
       .function("encode_raw_ptr", &encode_raw_ptrs)
+      .function("decode_raw_ptr", &decode_raw_ptrs)
+      .function("check_raw_ptr", &check_raw_ptrs)
+      .function("encode_batch_raw_ptr", &encode_batch_raw_ptrs)
+      .function("decode_batch_raw_ptr", &decode_batch_raw_ptrs)
+
+      // Uint8Array Byte API (copies)
+      .function("encode_bytes", &encode_bytes_wrapper)
+      .function("decode_bytes", &decode_bytes_wrapper)
 
       .property("ecc_bytes", &lite::LiteBCH::get_ecc_bytes)
+      .function("table_bytes", &table_bytes)
+      .function("workspace_bytes", &workspace_bytes)
+
+      .function("serialize_tables", &serialize_tables)
 
       .function("decode", static_cast<bool (lite::LiteBCH::*)(
                               const std::vector<int> &, std::vector<int> &)>(
                               &lite::LiteBCH::decode));
+
+  // Batch codec over a shared code (threads: 0 = hardware concurrency, at
+  // most that many)
+  class_<lite::ParallelBCH>("ParallelBCH")
+      .constructor(&create_parallel, allow_raw_pointers())
+      .function("get_threads", &lite::ParallelBCH::get_threads)
+      .function("encode_batch_raw_ptr", &parallel_encode_batch)
+      .function("decode_batch_raw_ptr", &parallel_decode_batch);
+
+  function("vector_backend", &vector_backend);
 }
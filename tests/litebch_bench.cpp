@@ -0,0 +1,564 @@
+// LiteBCH benchmark suite.
+//
+// Sweeps field order m, correction capability t, data length and injected
+// error count. For every configuration it reports encode throughput (one
+// codeword at a time and through encode_batch), the
+// mean cost of each decoder stage (syndromes, Berlekamp-Massey, root
+// search, correction), the p50/p99 latency of a full decode() per codeword
+// and, for m <= 15, the same figures for the bundled Linux kernel codec.
+//
+// Output is a console table by default, or CSV / JSON for tracking results
+// across commits (--csv, --json, --out FILE).
+
+#include "bch_codec.h" // Kernel BCH
+#include <litebch/LiteBCH.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lite {
+
+// Stage-by-stage view of LiteBCHCode::decode_core.
+struct DecoderStages {
+  using Workspace = LiteBCHCode::Workspace;
+
+  static bool syndromes(const LiteBCHCode &code, const uint8_t *data,
+                        size_t len, const uint8_t *ecc, Workspace &ws) {
+    return code.remainder_syndromes(data, len, ecc, ws);
+  }
+  static int locator(const LiteBCHCode &code, Workspace &ws) {
+    return code.berlekamp_massey(ws);
+  }
+  static int roots(const LiteBCHCode &code, size_t len, int deg,
+                   Workspace &ws) {
+    return code.find_roots(ws.lambda.data(), deg,
+                           code.n_rdncy + code.data_bits(len), ws.loc.data(),
+                           ws);
+  }
+  static void correct(const LiteBCHCode &code, uint8_t *data, size_t len,
+                      uint8_t *ecc, int count, const Workspace &ws) {
+    code.correct_errors(data, len, ecc, count, ws);
+  }
+};
+
+} // namespace lite
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ns_since(Clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count();
+}
+
+struct Options {
+  std::vector<int> m = {8, 10, 13, 15};
+  std::vector<int> t = {4, 8, 16, 40};
+  std::vector<std::string> errors = {"0", "1", "t/2", "t"};
+  std::vector<std::string> lens = {"512", "1024", "2048", "full"};
+  int count = 256; // codewords per configuration
+  int iters = 5;   // passes over the codewords per measurement
+  bool kernel = true;
+  std::string simd = "auto";    // SIMD backend (lite::set_vector_backend)
+  std::string encoder = "auto"; // message encoder (lite::set_encode_backend)
+  enum { TABLE, CSV, JSON } format = TABLE;
+  std::string out;
+};
+
+struct Result {
+  int m, N, t, K, ecc_bits;
+  size_t len;
+  int errors;
+  double encode_mbps, encode_batch_mbps;
+  double syndrome_ns, bm_ns, roots_ns, correct_ns;
+  double decode_p50_ns, decode_p99_ns, decode_mean_ns, decode_mbps;
+  int failures;
+  bool has_kernel;
+  size_t kernel_len;
+  double kernel_encode_mbps;
+  double kernel_p50_ns, kernel_p99_ns, kernel_mean_ns, kernel_decode_mbps;
+};
+
+std::vector<std::string> split(const std::string &s) {
+  std::vector<std::string> out;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    if (!item.empty())
+      out.push_back(item);
+  return out;
+}
+
+std::vector<int> split_ints(const std::string &s) {
+  std::vector<int> out;
+  for (const auto &item : split(s))
+    out.push_back(std::atoi(item.c_str()));
+  return out;
+}
+
+void usage(const char *prog) {
+  std::cerr
+      << "Usage: " << prog << " [options]\n"
+      << "  --m LIST       field orders (default 8,10,13,15)\n"
+      << "  --t LIST       correction capabilities (default 4,8,16,40)\n"
+      << "  --errors LIST  injected errors; integers, 't' or 't/2'\n"
+      << "                 (default 0,1,t/2,t)\n"
+      << "  --lens LIST    data lengths in bytes, or 'full'\n"
+      << "                 (default 512,1024,2048,full)\n"
+      << "  --count N      codewords per configuration (default 256)\n"
+      << "  --iters N      passes per measurement (default 5)\n"
+      << "  --no-kernel    skip the Linux kernel codec comparison\n"
+      << "  --simd NAME    SIMD backend: avx512, avx2, ssse3, neon,\n"
+      << "                 wasm-simd128, scalar or auto (default)\n"
+      << "  --encoder NAME message encoder: pclmul, pmull, table or auto\n"
+      << "  --csv | --json machine-readable output\n"
+      << "  --out FILE     write output to FILE instead of stdout\n"
+      << "                 (CSV unless --json is given)\n";
+}
+
+bool parse(int argc, char **argv, Options &opt) {
+  for (int i = 1; i < argc; ++i) {
+    std::string a = argv[i];
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        std::cerr << "Missing value for " << a << "\n";
+        std::exit(1);
+      }
+      return argv[++i];
+    };
+    if (a == "--m")
+      opt.m = split_ints(value());
+    else if (a == "--t")
+      opt.t = split_ints(value());
+    else if (a == "--errors")
+      opt.errors = split(value());
+    else if (a == "--lens")
+      opt.lens = split(value());
+    else if (a == "--count")
+      opt.count = std::max(1, std::atoi(value().c_str()));
+    else if (a == "--iters")
+      opt.iters = std::max(1, std::atoi(value().c_str()));
+    else if (a == "--no-kernel")
+      opt.kernel = false;
+    else if (a == "--simd")
+      opt.simd = value();
+    else if (a == "--encoder")
+      opt.encoder = value();
+    else if (a == "--csv")
+      opt.format = Options::CSV;
+    else if (a == "--json")
+      opt.format = Options::JSON;
+    else if (a == "--out")
+      opt.out = value();
+    else {
+      usage(argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+int resolve_errors(const std::string &spec, int t) {
+  if (spec == "t")
+    return t;
+  if (spec == "t/2")
+    return t / 2;
+  return std::atoi(spec.c_str());
+}
+
+double percentile(std::vector<double> &v, double p) {
+  if (v.empty())
+    return 0.0;
+  size_t k = static_cast<size_t>(p * (v.size() - 1) + 0.5);
+  std::nth_element(v.begin(), v.begin() + k, v.end());
+  return v[k];
+}
+
+// Flips 'errors' distinct bits among the 'bits' positions of a codeword;
+// flip(pos) maps a position to the bit to toggle.
+template <class Flip>
+void inject(std::mt19937 &rng, int bits, int errors, Flip flip) {
+  std::vector<int> pos;
+  std::uniform_int_distribution<int> dist(0, bits - 1);
+  while ((int)pos.size() < errors) {
+    int p = dist(rng);
+    if (std::find(pos.begin(), pos.end(), p) == pos.end())
+      pos.push_back(p);
+  }
+  for (int p : pos)
+    flip(p);
+}
+
+Result run_litebch(int m, int t, size_t len_req, int errors,
+                   const Options &opt, std::mt19937 &rng) {
+  const int N = (1 << m) - 1;
+  auto code = lite::LiteBCHCode::get(N, t);
+  lite::LiteBCHCode::Workspace ws(*code);
+  using Stages = lite::DecoderStages;
+
+  Result r{};
+  r.m = m;
+  r.N = N;
+  r.t = t;
+  r.K = code->get_K();
+  r.ecc_bits = N - r.K;
+  r.errors = errors;
+
+  // len_req = 0 is the full-length code, anything shorter is shortened.
+  const size_t len = len_req ? len_req : (r.K + 7) / 8;
+  const int data_bits = std::min(r.K, 8 * (int)len);
+  const int n_bits = data_bits + r.ecc_bits;
+  const size_t eb = code->get_ecc_bytes();
+  r.len = len;
+
+  const int n = opt.count;
+  std::vector<uint8_t> data(n * len), ecc(n * eb);
+  std::uniform_int_distribution<int> byte(0, 255);
+  for (auto &b : data)
+    b = (uint8_t)byte(rng);
+
+  // Encode
+  auto start = Clock::now();
+  for (int it = 0; it < opt.iters; ++it)
+    for (int c = 0; c < n; ++c)
+      code->encode(&data[c * len], len, &ecc[c * eb], ws);
+  double enc_ns = ns_since(start);
+  r.encode_mbps = (double)data_bits * n * opt.iters / enc_ns * 1e3;
+
+  start = Clock::now();
+  for (int it = 0; it < opt.iters; ++it)
+    code->encode_batch(data.data(), len, len, n, ecc.data(), eb, ws);
+  enc_ns = ns_since(start);
+  r.encode_batch_mbps = (double)data_bits * n * opt.iters / enc_ns * 1e3;
+
+  // Received words: data bits are MSB-first, ECC bits LSB-first.
+  std::vector<uint8_t> rx_data = data, rx_ecc = ecc;
+  for (int c = 0; c < n; ++c) {
+    uint8_t *d = &rx_data[c * len];
+    uint8_t *e = &rx_ecc[c * eb];
+    inject(rng, n_bits, std::min(errors, n_bits), [&](int p) {
+      if (p < data_bits)
+        d[p >> 3] ^= (uint8_t)(0x80 >> (p & 7));
+      else
+        e[(p - data_bits) >> 3] ^= (uint8_t)(1 << ((p - data_bits) & 7));
+    });
+  }
+
+  std::vector<uint8_t> work_data(rx_data.size()), work_ecc(rx_ecc.size());
+
+  // Per-stage timings, averaged over every codeword that reaches the stage.
+  double syn = 0, bm = 0, roots = 0, corr = 0;
+  long syn_n = 0, bm_n = 0, roots_n = 0, corr_n = 0;
+  for (int it = 0; it < opt.iters; ++it) {
+    work_data = rx_data;
+    work_ecc = rx_ecc;
+    for (int c = 0; c < n; ++c) {
+      uint8_t *d = &work_data[c * len];
+      uint8_t *e = &work_ecc[c * eb];
+      auto t0 = Clock::now();
+      bool dirty = Stages::syndromes(*code, d, len, e, ws);
+      syn += ns_since(t0);
+      syn_n++;
+      if (!dirty)
+        continue;
+      t0 = Clock::now();
+      int deg = Stages::locator(*code, ws);
+      bm += ns_since(t0);
+      bm_n++;
+      if (deg < 0)
+        continue;
+      t0 = Clock::now();
+      int cnt = Stages::roots(*code, len, deg, ws);
+      roots += ns_since(t0);
+      roots_n++;
+      if (cnt != deg)
+        continue;
+      t0 = Clock::now();
+      Stages::correct(*code, d, len, e, cnt, ws);
+      corr += ns_since(t0);
+      corr_n++;
+    }
+  }
+  r.syndrome_ns = syn_n ? syn / syn_n : 0;
+  r.bm_ns = bm_n ? bm / bm_n : 0;
+  r.roots_ns = roots_n ? roots / roots_n : 0;
+  r.correct_ns = corr_n ? corr / corr_n : 0;
+
+  // Full decode latency per codeword.
+  std::vector<double> lat;
+  lat.reserve((size_t)n * opt.iters);
+  r.failures = 0;
+  for (int it = 0; it < opt.iters; ++it) {
+    work_data = rx_data;
+    work_ecc = rx_ecc;
+    for (int c = 0; c < n; ++c) {
+      uint8_t *d = &work_data[c * len];
+      uint8_t *e = &work_ecc[c * eb];
+      auto t0 = Clock::now();
+      int res = code->decode(d, len, e, ws);
+      lat.push_back(ns_since(t0));
+      if (it == 0 && errors <= t &&
+          (res != errors || std::memcmp(d, &data[c * len], len) != 0))
+        r.failures++;
+    }
+  }
+  double sum = 0;
+  for (double v : lat)
+    sum += v;
+  r.decode_mean_ns = sum / lat.size();
+  r.decode_p50_ns = percentile(lat, 0.50);
+  r.decode_p99_ns = percentile(lat, 0.99);
+  r.decode_mbps = (double)n_bits / r.decode_mean_ns * 1e3;
+  return r;
+}
+
+void run_kernel(Result &r, const Options &opt, std::mt19937 &rng) {
+  r.has_kernel = false;
+  if (!opt.kernel || r.m < 5 || r.m > 15)
+    return;
+  struct bch_control *bch = init_bch(r.m, r.t, 0);
+  if (!bch)
+    return;
+
+  // The kernel codec takes whole data bytes only.
+  const size_t len = std::min(r.len, (size_t)(bch->n - bch->ecc_bits) / 8);
+  const size_t eb = bch->ecc_bytes;
+  const int n = opt.count;
+  r.has_kernel = true;
+  r.kernel_len = len;
+
+  std::vector<uint8_t> data(n * len), ecc(n * eb);
+  std::uniform_int_distribution<int> byte(0, 255);
+  for (auto &b : data)
+    b = (uint8_t)byte(rng);
+
+  auto start = Clock::now();
+  for (int it = 0; it < opt.iters; ++it)
+    for (int c = 0; c < n; ++c) {
+      std::memset(&ecc[c * eb], 0, eb);
+      encode_bch(bch, &data[c * len], (unsigned)len, &ecc[c * eb]);
+    }
+  double enc_ns = ns_since(start);
+  r.kernel_encode_mbps = (double)len * 8 * n * opt.iters / enc_ns * 1e3;
+
+  // Errors go into the data bytes; the kernel's ECC packing differs from
+  // LiteBCH's, and data errors exercise the same decoder path.
+  std::vector<uint8_t> rx = data;
+  const int bits = (int)len * 8;
+  for (int c = 0; c < n; ++c) {
+    uint8_t *d = &rx[c * len];
+    inject(rng, bits, std::min(r.errors, bits),
+           [&](int p) { d[p >> 3] ^= (uint8_t)(1 << (p & 7)); });
+  }
+
+  std::vector<uint8_t> work(rx.size());
+  std::vector<unsigned int> errloc(r.t);
+  std::vector<double> lat;
+  lat.reserve((size_t)n * opt.iters);
+  for (int it = 0; it < opt.iters; ++it) {
+    work = rx;
+    for (int c = 0; c < n; ++c) {
+      uint8_t *d = &work[c * len];
+      auto t0 = Clock::now();
+      int nerr = decode_bch(bch, d, (unsigned)len, &ecc[c * eb], nullptr,
+                            nullptr, errloc.data());
+      if (nerr > 0)
+        correct_bch(bch, d, (unsigned)len, errloc.data(), nerr);
+      lat.push_back(ns_since(t0));
+    }
+  }
+  double sum = 0;
+  for (double v : lat)
+    sum += v;
+  r.kernel_mean_ns = sum / lat.size();
+  r.kernel_p50_ns = percentile(lat, 0.50);
+  r.kernel_p99_ns = percentile(lat, 0.99);
+  r.kernel_decode_mbps = (double)(len * 8 + bch->ecc_bits) /
+                         r.kernel_mean_ns * 1e3;
+  free_bch(bch);
+}
+
+const char *kFields[] = {
+    "m",           "N",           "t",           "K",
+    "len",         "errors",      "encode_mbps", "encode_batch_mbps",
+    "syndrome_ns",
+    "bm_ns",       "roots_ns",    "correct_ns",  "decode_p50_ns",
+    "decode_p99_ns", "decode_mean_ns", "decode_mbps", "failures",
+    "kernel_len",  "kernel_encode_mbps", "kernel_p50_ns", "kernel_p99_ns",
+    "kernel_decode_mbps"};
+
+std::vector<std::string> values(const Result &r) {
+  auto num = [](double v) {
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1) << v;
+    return os.str();
+  };
+  auto k = [&](double v) { return r.has_kernel ? num(v) : std::string(); };
+  return {std::to_string(r.m),
+          std::to_string(r.N),
+          std::to_string(r.t),
+          std::to_string(r.K),
+          std::to_string(r.len),
+          std::to_string(r.errors),
+          num(r.encode_mbps),
+          num(r.encode_batch_mbps),
+          num(r.syndrome_ns),
+          num(r.bm_ns),
+          num(r.roots_ns),
+          num(r.correct_ns),
+          num(r.decode_p50_ns),
+          num(r.decode_p99_ns),
+          num(r.decode_mean_ns),
+          num(r.decode_mbps),
+          std::to_string(r.failures),
+          r.has_kernel ? std::to_string(r.kernel_len) : std::string(),
+          k(r.kernel_encode_mbps),
+          k(r.kernel_p50_ns),
+          k(r.kernel_p99_ns),
+          k(r.kernel_decode_mbps)};
+}
+
+void print_csv(std::ostream &os, const std::vector<Result> &results) {
+  const size_t nf = sizeof(kFields) / sizeof(kFields[0]);
+  for (size_t i = 0; i < nf; ++i)
+    os << (i ? "," : "") << kFields[i];
+  os << "\n";
+  for (const auto &r : results) {
+    auto v = values(r);
+    for (size_t i = 0; i < nf; ++i)
+      os << (i ? "," : "") << v[i];
+    os << "\n";
+  }
+}
+
+void print_json(std::ostream &os, const std::vector<Result> &results,
+                const Options &opt) {
+  const size_t nf = sizeof(kFields) / sizeof(kFields[0]);
+  os << "{\n  \"benchmark\": \"litebch\",\n"
+     << "  \"count\": " << opt.count << ",\n"
+     << "  \"iters\": " << opt.iters << ",\n"
+     << "  \"results\": [\n";
+  for (size_t r = 0; r < results.size(); ++r) {
+    auto v = values(results[r]);
+    os << "    {";
+    bool first = true;
+    for (size_t i = 0; i < nf; ++i) {
+      if (v[i].empty())
+        continue;
+      os << (first ? "" : ", ") << "\"" << kFields[i] << "\": " << v[i];
+      first = false;
+    }
+    os << "}" << (r + 1 < results.size() ? "," : "") << "\n";
+  }
+  os << "  ]\n}\n";
+}
+
+void print_row(const Result &r) {
+  std::cout << std::fixed << std::setprecision(1) << "| " << std::setw(2)
+            << r.m << " | " << std::setw(3) << r.t << " | " << std::setw(5)
+            << r.len << " | " << std::setw(3) << r.errors << " | "
+            << std::setw(8) << r.encode_mbps << " | " << std::setw(8)
+            << r.encode_batch_mbps << " | " << std::setw(7)
+            << r.syndrome_ns << " | " << std::setw(7) << r.bm_ns << " | "
+            << std::setw(7) << r.roots_ns << " | " << std::setw(6)
+            << r.correct_ns << " | " << std::setw(8) << r.decode_p50_ns
+            << " | " << std::setw(8) << r.decode_p99_ns << " | ";
+  if (r.has_kernel)
+    std::cout << std::setw(8) << r.kernel_p50_ns << " | " << std::setw(8)
+              << r.kernel_p99_ns << " |";
+  else
+    std::cout << "       - |        - |";
+  if (r.failures)
+    std::cout << " " << r.failures << " FAILED";
+  std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parse(argc, argv, opt))
+    return 1;
+  try {
+    lite::set_vector_backend(opt.simd);
+    lite::set_encode_backend(opt.encoder);
+  } catch (const std::invalid_argument &e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+
+  if (opt.format == Options::TABLE && opt.out.empty()) {
+    std::cout << "LiteBCH Benchmark (" << opt.count << " codewords x "
+              << opt.iters << " passes, stage and latency figures in ns, "
+              << lite::get_vector_backend() << " / "
+              << lite::get_encode_backend() << ")\n";
+    std::cout << "|  m |   t |   len | err |  enc Mbps | benc Mbps |     syn "
+                 "|      bm "
+                 "|   roots |   corr |  dec p50 |  dec p99 |  krn p50 |  krn "
+                 "p99 |\n";
+    std::cout << "|----|-----|-------|-----|----------|----------|---------|"
+                 "---------|"
+                 "---------|--------|----------|----------|----------|------"
+                 "----|\n";
+  }
+
+  std::mt19937 rng(12345);
+  std::vector<Result> results;
+  int failures = 0;
+  for (int m : opt.m) {
+    if (m < 3 || m > 24) {
+      std::cerr << "Skipping unsupported m=" << m << "\n";
+      continue;
+    }
+    const int N = (1 << m) - 1;
+    for (int t : opt.t) {
+      if (t < 1 || m * t >= N)
+        continue;
+      for (const auto &len : opt.lens) {
+        size_t len_req = len == "full" ? 0 : (size_t)std::atoi(len.c_str());
+        const int K = lite::LiteBCHCode::get(N, t)->get_K();
+        if (len != "full" && (len_req == 0 || 8 * len_req >= (size_t)K))
+          continue; // not shorter than the full-length code
+        for (const auto &spec : opt.errors) {
+          int e = resolve_errors(spec, t);
+          if (e < 0)
+            continue;
+          Result r = run_litebch(m, t, len_req, e, opt, rng);
+          run_kernel(r, opt, rng);
+          failures += r.failures;
+          results.push_back(r);
+          if (opt.format == Options::TABLE && opt.out.empty())
+            print_row(r);
+        }
+      }
+    }
+  }
+
+  if (opt.format != Options::TABLE || !opt.out.empty()) {
+    std::ofstream file;
+    if (!opt.out.empty()) {
+      file.open(opt.out);
+      if (!file) {
+        std::cerr << "Cannot open " << opt.out << "\n";
+        return 1;
+      }
+    }
+    std::ostream &os = opt.out.empty() ? std::cout : file;
+    if (opt.format == Options::JSON)
+      print_json(os, results, opt);
+    else
+      print_csv(os, results);
+  }
+  return failures ? 1 : 0;
+}
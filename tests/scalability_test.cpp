@@ -0,0 +1,571 @@
+// LiteBCH scalability suite.
+//
+// Sweeps m = 5..16 and t over full-length codewords. For every
+// configuration it records the table construction time, the table and
+// Workspace memory, encode throughput and the decode time per codeword with
+// 0, t/2 and t errors. Two kinds of regression are flagged:
+//  * superlinear scaling: the cost per codeword is O(t N), so the log-log
+//    slope of every cost, fitted over a t sweep (m fixed) or an N sweep
+//    (t fixed), and of the decode time from t/2 to t errors must stay below
+//    a limit (--slope);
+//  * baselines: against a stored CSV (--baseline FILE), table memory must
+//    not grow and no timing may be more than --tolerance times slower.
+// --save FILE writes the results as a new baseline. Timings only compare
+// on the machine that wrote the baseline; --tolerance 0 checks the memory
+// columns alone, which are the same on every target.
+//
+// tests/wasm_scalability_test.js runs the same sweep on the WASM build.
+
+#include <litebch/LiteBCH.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ns_since(Clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count();
+}
+
+struct Options {
+  std::vector<int> m = {5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  std::vector<int> t = {1, 2, 4, 8, 16, 32, 64};
+  int passes = 5;         // timings are the best pass
+  double bits = 1 << 22;  // codeword bits per pass and configuration
+  double slope = 1.5;     // largest log-log slope of a cost
+  double tolerance = 2.0; // largest slowdown against the baseline (0: off)
+  double mem_slack = 0.02;
+  std::string baseline, save;
+  enum { TABLE, CSV, JSON } format = TABLE;
+  std::string out;
+};
+
+struct Result {
+  int m, N, t, K;
+  double build_us;
+  size_t table_bytes, workspace_bytes;
+  double encode_mbps;
+  double decode_clean_ns, decode_half_ns, decode_t_ns;
+  int failures;
+};
+
+std::vector<int> split_ints(const std::string &s) {
+  std::vector<int> out;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    if (!item.empty())
+      out.push_back(std::atoi(item.c_str()));
+  return out;
+}
+
+void usage(const char *prog) {
+  std::cerr
+      << "Usage: " << prog << " [options]\n"
+      << "  --m LIST        field orders (default 5..16)\n"
+      << "  --t LIST        correction capabilities (default 1,2,...,64)\n"
+      << "  --quick         m = 5,8,11,13 and t <= 16, fewer passes\n"
+      << "  --passes N      timing passes, the best counts (default 5)\n"
+      << "  --slope X       largest log-log slope of a cost (default 1.5)\n"
+      << "  --baseline FILE compare against a baseline CSV\n"
+      << "  --tolerance X   largest slowdown against it (default 2,\n"
+      << "                  0 compares memory only)\n"
+      << "  --save FILE     write the results as a baseline CSV\n"
+      << "  --csv | --json  machine-readable output\n"
+      << "  --out FILE      write output to FILE instead of stdout\n";
+}
+
+bool parse(int argc, char **argv, Options &opt) {
+  for (int i = 1; i < argc; ++i) {
+    std::string a = argv[i];
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        std::cerr << "Missing value for " << a << "\n";
+        std::exit(1);
+      }
+      return argv[++i];
+    };
+    if (a == "--m")
+      opt.m = split_ints(value());
+    else if (a == "--t")
+      opt.t = split_ints(value());
+    else if (a == "--quick") {
+      opt.m = {5, 8, 11, 13};
+      opt.t = {1, 2, 4, 8, 16};
+      opt.passes = 3;
+      opt.bits = 1 << 20;
+    } else if (a == "--passes")
+      opt.passes = std::max(1, std::atoi(value().c_str()));
+    else if (a == "--slope")
+      opt.slope = std::atof(value().c_str());
+    else if (a == "--baseline")
+      opt.baseline = value();
+    else if (a == "--tolerance")
+      opt.tolerance = std::atof(value().c_str());
+    else if (a == "--save")
+      opt.save = value();
+    else if (a == "--csv")
+      opt.format = Options::CSV;
+    else if (a == "--json")
+      opt.format = Options::JSON;
+    else if (a == "--out")
+      opt.out = value();
+    else {
+      usage(argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Received words with 'errors' distinct flipped bits each, anywhere in the
+// codeword (data bits MSB-first, ECC bits LSB-first)
+void inject(std::mt19937 &rng, uint8_t *data, uint8_t *ecc, int data_bits,
+            int ecc_bits, int errors) {
+  std::vector<int> pos;
+  std::uniform_int_distribution<int> dist(0, data_bits + ecc_bits - 1);
+  while ((int)pos.size() < errors) {
+    int p = dist(rng);
+    if (std::find(pos.begin(), pos.end(), p) == pos.end())
+      pos.push_back(p);
+  }
+  for (int p : pos) {
+    if (p < data_bits)
+      data[p >> 3] ^= (uint8_t)(0x80 >> (p & 7));
+    else
+      ecc[(p - data_bits) >> 3] ^= (uint8_t)(1 << ((p - data_bits) & 7));
+  }
+}
+
+Result run(int m, int t, const Options &opt, std::mt19937 &rng) {
+  const int N = (1 << m) - 1;
+  Result r{};
+  r.m = m;
+  r.N = N;
+  r.t = t;
+
+  // Construction with every table (best pass, not from the code cache)
+  r.build_us = 1e30;
+  for (int p = 0; p < opt.passes; ++p) {
+    auto start = Clock::now();
+    lite::LiteBCHCode fresh(N, t);
+    r.build_us = std::min(r.build_us, ns_since(start) / 1e3);
+  }
+
+  auto code = lite::LiteBCHCode::get(N, t);
+  lite::LiteBCHCode::Workspace ws(*code);
+  lite::LiteBCHCode::MemoryUsage mem = code->memory_usage();
+  r.K = code->get_K();
+  r.table_bytes = mem.gf + mem.encoder + mem.decoder;
+
+  const size_t len = (r.K + 7) / 8;
+  const size_t eb = code->get_ecc_bytes();
+  const int n = std::max(8, (int)(opt.bits / N));
+  std::vector<uint8_t> data(n * len), ecc(n * eb);
+  std::uniform_int_distribution<int> byte(0, 255);
+  for (auto &b : data)
+    b = (uint8_t)byte(rng);
+
+  double best = 1e30;
+  for (int p = 0; p < opt.passes; ++p) {
+    auto start = Clock::now();
+    for (int c = 0; c < n; ++c)
+      code->encode(&data[c * len], len, &ecc[c * eb], ws);
+    best = std::min(best, ns_since(start));
+  }
+  r.encode_mbps = (double)r.K * n / best * 1e3;
+
+  // Decode time per codeword for each error count; every word must come
+  // back corrected.
+  std::vector<uint8_t> rx_data(data.size()), rx_ecc(ecc.size());
+  std::vector<uint8_t> work_data(data.size()), work_ecc(ecc.size());
+  const int counts[] = {0, t / 2, t};
+  double *out[] = {&r.decode_clean_ns, &r.decode_half_ns, &r.decode_t_ns};
+  for (int k = 0; k < 3; ++k) {
+    rx_data = data;
+    rx_ecc = ecc;
+    for (int c = 0; c < n; ++c)
+      inject(rng, &rx_data[c * len], &rx_ecc[c * eb], r.K, N - r.K,
+             counts[k]);
+    best = 1e30;
+    for (int p = 0; p < opt.passes; ++p) {
+      work_data = rx_data;
+      work_ecc = rx_ecc;
+      int bad = 0;
+      auto start = Clock::now();
+      for (int c = 0; c < n; ++c)
+        bad += code->decode(&work_data[c * len], len, &work_ecc[c * eb], ws) !=
+               counts[k];
+      best = std::min(best, ns_since(start));
+      if (p == 0)
+        r.failures += bad + (work_data != data) + (work_ecc != ecc);
+    }
+    *out[k] = best / n;
+  }
+  r.workspace_bytes = ws.memory_usage();
+  return r;
+}
+
+void keep_best(Result &r, const Result &again) {
+  r.build_us = std::min(r.build_us, again.build_us);
+  r.encode_mbps = std::max(r.encode_mbps, again.encode_mbps);
+  r.decode_clean_ns = std::min(r.decode_clean_ns, again.decode_clean_ns);
+  r.decode_half_ns = std::min(r.decode_half_ns, again.decode_half_ns);
+  r.decode_t_ns = std::min(r.decode_t_ns, again.decode_t_ns);
+  r.failures += again.failures;
+}
+
+const char *kFields[] = {"m",
+                         "N",
+                         "t",
+                         "K",
+                         "build_us",
+                         "table_bytes",
+                         "workspace_bytes",
+                         "encode_mbps",
+                         "decode_clean_ns",
+                         "decode_half_ns",
+                         "decode_t_ns"};
+const size_t kNumFields = sizeof(kFields) / sizeof(kFields[0]);
+
+std::vector<std::string> values(const Result &r) {
+  auto num = [](double v) {
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1) << v;
+    return os.str();
+  };
+  return {std::to_string(r.m),           std::to_string(r.N),
+          std::to_string(r.t),           std::to_string(r.K),
+          num(r.build_us),               std::to_string(r.table_bytes),
+          std::to_string(r.workspace_bytes), num(r.encode_mbps),
+          num(r.decode_clean_ns),        num(r.decode_half_ns),
+          num(r.decode_t_ns)};
+}
+
+void print_csv(std::ostream &os, const std::vector<Result> &results) {
+  for (size_t i = 0; i < kNumFields; ++i)
+    os << (i ? "," : "") << kFields[i];
+  os << "\n";
+  for (const auto &r : results) {
+    auto v = values(r);
+    for (size_t i = 0; i < kNumFields; ++i)
+      os << (i ? "," : "") << v[i];
+    os << "\n";
+  }
+}
+
+void print_json(std::ostream &os, const std::vector<Result> &results,
+                const std::vector<std::string> &flags) {
+  os << "{\n  \"benchmark\": \"scalability\",\n"
+     << "  \"backend\": \"" << lite::get_vector_backend() << " / "
+     << lite::get_encode_backend() << "\",\n"
+     << "  \"results\": [\n";
+  for (size_t r = 0; r < results.size(); ++r) {
+    auto v = values(results[r]);
+    os << "    {";
+    for (size_t i = 0; i < kNumFields; ++i)
+      os << (i ? ", " : "") << "\"" << kFields[i] << "\": " << v[i];
+    os << "}" << (r + 1 < results.size() ? "," : "") << "\n";
+  }
+  os << "  ],\n  \"regressions\": [";
+  for (size_t i = 0; i < flags.size(); ++i)
+    os << (i ? ", " : "") << "\"" << flags[i] << "\"";
+  os << "]\n}\n";
+}
+
+void print_row(const Result &r) {
+  std::cout << std::fixed << std::setprecision(1) << "| " << std::setw(2)
+            << r.m << " | " << std::setw(5) << r.N << " | " << std::setw(2)
+            << r.t << " | " << std::setw(8) << r.build_us << " | "
+            << std::setw(9) << r.table_bytes << " | " << std::setw(7)
+            << r.workspace_bytes << " | " << std::setw(8) << r.encode_mbps
+            << " | " << std::setw(9) << r.decode_clean_ns << " | "
+            << std::setw(9) << r.decode_half_ns << " | " << std::setw(9)
+            << r.decode_t_ns << " |";
+  if (r.failures)
+    std::cout << " " << r.failures << " FAILED";
+  std::cout << "\n";
+}
+
+// --- Checks ---
+
+// Costs of a configuration, higher is worse: per codeword, so that each is
+// O(t N) at most. ns converts a timing to nanoseconds (0: not a timing);
+// roots marks the decode with t errors, which runs a root search.
+struct Cost {
+  const char *name;
+  double (*get)(const Result &);
+  double ns;
+  bool roots;
+};
+const Cost kCosts[] = {
+    {"build_us", [](const Result &r) { return r.build_us; }, 1e3, false},
+    {"table_bytes", [](const Result &r) { return (double)r.table_bytes; }, 0,
+     false},
+    {"encode_ns", [](const Result &r) { return r.K / r.encode_mbps * 1e3; },
+     1, false},
+    {"decode_clean_ns", [](const Result &r) { return r.decode_clean_ns; }, 1,
+     false},
+    {"decode_t_ns", [](const Result &r) { return r.decode_t_ns; }, 1, true}};
+
+// Timings this short are mostly call overhead and noise; their slopes say
+// nothing about scaling.
+const double kMinNs = 2000;
+
+// Error locators up to this degree are solved in closed form, without the
+// Chien search, so decode times only compare above it.
+const int kClosedForm = 4;
+
+std::string config(const Result &r) {
+  return "m=" + std::to_string(r.m) + " t=" + std::to_string(r.t);
+}
+
+// Least-squares slope of log y over log x
+double fit_slope(const std::vector<std::pair<double, double>> &pts) {
+  double sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (const auto &p : pts) {
+    const double x = std::log(p.first), y = std::log(p.second);
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+  }
+  const double n = (double)pts.size();
+  return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+}
+
+// One sweep: the configurations in order of the axis (t or N). Slopes are
+// fitted over the whole sweep, as neighbouring points alone are too noisy
+// on a shared machine.
+void check_sweep(const std::vector<const Result *> &sweep, bool along_t,
+                 const Options &opt, std::vector<std::string> &flags) {
+  for (const Cost &c : kCosts) {
+    std::vector<std::pair<double, double>> pts;
+    const Result *first = nullptr, *last = nullptr;
+    for (const Result *r : sweep) {
+      const double y = c.get(*r);
+      if (y <= 0 || (c.ns && y * c.ns < kMinNs) ||
+          (c.roots && r->t <= kClosedForm))
+        continue;
+      pts.push_back({along_t ? (double)r->t : (double)r->N, y});
+      if (!first)
+        first = r;
+      last = r;
+    }
+    if (pts.size() < 3)
+      continue;
+    const double slope = fit_slope(pts);
+    if (slope > opt.slope) {
+      std::ostringstream os;
+      os << std::fixed << std::setprecision(2) << c.name << " grows as "
+         << (along_t ? "t" : "N") << "^" << slope << " from " << config(*first)
+         << " to " << config(*last);
+      flags.push_back(os.str());
+    }
+  }
+}
+
+void check_scaling(const std::vector<Result> &results, const Options &opt,
+                   std::vector<std::string> &flags) {
+  std::map<int, std::vector<const Result *>> by_m, by_t;
+  for (const auto &r : results) {
+    by_m[r.m].push_back(&r);
+    by_t[r.t].push_back(&r);
+  }
+  for (auto &e : by_m) {
+    auto &sweep = e.second;
+    std::sort(sweep.begin(), sweep.end(),
+              [](const Result *a, const Result *b) { return a->t < b->t; });
+    check_sweep(sweep, true, opt, flags);
+
+    // t/2 -> t errors, averaged over the sweep
+    double sum = 0;
+    int n = 0;
+    for (const Result *r : sweep) {
+      if (r->t / 2 <= kClosedForm || r->decode_t_ns < kMinNs)
+        continue;
+      sum += std::log(r->decode_t_ns / r->decode_half_ns) /
+             std::log((double)r->t / (r->t / 2));
+      n++;
+    }
+    if (n >= 2 && sum / n > opt.slope) {
+      std::ostringstream os;
+      os << std::fixed << std::setprecision(2)
+         << "decode_t_ns grows as errors^" << sum / n << " at m=" << e.first;
+      flags.push_back(os.str());
+    }
+  }
+  for (auto &e : by_t) {
+    auto &sweep = e.second;
+    std::sort(sweep.begin(), sweep.end(),
+              [](const Result *a, const Result *b) { return a->m < b->m; });
+    check_sweep(sweep, false, opt, flags);
+  }
+}
+
+bool load_baseline(const std::string &path, std::vector<Result> &base) {
+  std::ifstream in(path);
+  if (!in)
+    return false;
+  std::string line;
+  std::getline(in, line); // header
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+    std::vector<double> v;
+    std::stringstream ss(line);
+    std::string item;
+    while (std::getline(ss, item, ','))
+      v.push_back(std::atof(item.c_str()));
+    if (v.size() < kNumFields)
+      continue;
+    Result r{};
+    r.m = (int)v[0];
+    r.N = (int)v[1];
+    r.t = (int)v[2];
+    r.K = (int)v[3];
+    r.build_us = v[4];
+    r.table_bytes = (size_t)v[5];
+    r.workspace_bytes = (size_t)v[6];
+    r.encode_mbps = v[7];
+    r.decode_clean_ns = v[8];
+    r.decode_half_ns = v[9];
+    r.decode_t_ns = v[10];
+    base.push_back(r);
+  }
+  return true;
+}
+
+void check_baseline(const std::vector<Result> &results,
+                    const std::vector<Result> &base, const Options &opt,
+                    std::vector<std::string> &flags) {
+  for (const auto &r : results) {
+    for (const auto &b : base) {
+      if (b.m != r.m || b.t != r.t)
+        continue;
+      if (r.table_bytes > b.table_bytes * (1 + opt.mem_slack))
+        flags.push_back("table_bytes " + std::to_string(r.table_bytes) +
+                        " > baseline " + std::to_string(b.table_bytes) +
+                        " at " + config(r));
+      if (opt.tolerance <= 0)
+        break;
+      for (const Cost &c : kCosts) {
+        const double now = c.get(r), was = c.get(b);
+        if (c.ns && was * c.ns >= kMinNs && now > was * opt.tolerance) {
+          std::ostringstream os;
+          os << std::fixed << std::setprecision(1) << c.name << " " << now
+             << " > " << opt.tolerance << " x baseline " << was << " at "
+             << config(r);
+          flags.push_back(os.str());
+        }
+      }
+      break;
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parse(argc, argv, opt))
+    return 1;
+
+  std::vector<Result> base;
+  if (!opt.baseline.empty() && !load_baseline(opt.baseline, base)) {
+    std::cerr << "Cannot read baseline " << opt.baseline << "\n";
+    return 1;
+  }
+
+  const bool table = opt.format == Options::TABLE && opt.out.empty();
+  if (table) {
+    std::cout << "LiteBCH Scalability (full-length codewords, best of "
+              << opt.passes << " passes, decode in ns per codeword, "
+              << lite::get_vector_backend() << " / "
+              << lite::get_encode_backend() << ")\n";
+    std::cout << "|  m |     N |  t | build us |    tables | wkspace | "
+                 "enc Mbps |  dec 0 err | dec t/2 err | dec t err |\n";
+    std::cout << "|----|-------|----|----------|-----------|---------|"
+                 "----------|-----------|-----------|-----------|\n";
+  }
+
+  std::mt19937 rng(12345);
+  std::vector<Result> results;
+  for (int m : opt.m) {
+    if (m < 5 || m > 24) {
+      std::cerr << "Skipping unsupported m=" << m << "\n";
+      continue;
+    }
+    const int N = (1 << m) - 1;
+    for (int t : opt.t) {
+      if (t < 1 || m * t >= N)
+        continue;
+      Result r = run(m, t, opt, rng);
+      results.push_back(r);
+      if (table)
+        print_row(r);
+    }
+  }
+
+  std::vector<std::string> flags;
+  check_scaling(results, opt, flags);
+  check_baseline(results, base, opt, flags);
+  if (!flags.empty()) {
+    // A slow spell of the machine looks like a regression: measure again
+    // and keep the better figures before reporting.
+    for (auto &r : results)
+      keep_best(r, run(r.m, r.t, opt, rng));
+    flags.clear();
+    check_scaling(results, opt, flags);
+    check_baseline(results, base, opt, flags);
+  }
+  int failures = 0;
+  for (const auto &r : results)
+    failures += r.failures;
+
+  if (!table) {
+    std::ofstream file;
+    if (!opt.out.empty()) {
+      file.open(opt.out);
+      if (!file) {
+        std::cerr << "Cannot open " << opt.out << "\n";
+        return 1;
+      }
+    }
+    std::ostream &os = opt.out.empty() ? std::cout : file;
+    if (opt.format == Options::JSON)
+      print_json(os, results, flags);
+    else
+      print_csv(os, results);
+  }
+  if (!opt.save.empty()) {
+    std::ofstream file(opt.save);
+    if (!file) {
+      std::cerr << "Cannot open " << opt.save << "\n";
+      return 1;
+    }
+    print_csv(file, results);
+  }
+
+  for (const auto &f : flags)
+    std::cerr << "REGRESSION: " << f << "\n";
+  if (failures)
+    std::cerr << failures << " codewords were not corrected\n";
+  return failures || !flags.empty() ? 1 : 0;
+}
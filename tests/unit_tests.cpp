@@ -1,6 +1,15 @@
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <litebch/LiteBCH.h>
+#include <litebch/ParallelBCH.h>
+#include <litebch/aff3ct_compat.h>
+#ifdef LITEBCH_STATIC_CODEC
+#include <litebch/StaticBCH.h>
+#endif
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Simple assertion helper
@@ -76,6 +85,1402 @@ int main() {
   }
   PASS("1-bit error correction");
 
+  // 5. Byte encoder (slice-by-4) vs bit-serial encoder
+  // Covers ecc_bits below, at and across 32-bit word boundaries and
+  // message lengths with a partial last byte.
+  {
+    const int cfgs[][2] = {{7, 1},    {15, 2},   {31, 6},    {63, 5},
+                           {255, 4},  {255, 16}, {1023, 13}, {8191, 40},
+                           {16383, 9}};
+    for (const auto &c : cfgs) {
+      lite::LiteBCH code(c[0], c[1]);
+      code.set_reference_mode(lite::ReferenceMode::BitSerial);
+      int k = code.get_K();
+      std::vector<int> msg(k);
+      for (int i = 0; i < k; ++i)
+        msg[i] = ((i * 7 + c[1]) % 5) < 2;
+      std::vector<int> cw = code.encode(msg);
+
+      std::vector<uint8_t> data((k + 7) / 8, 0);
+      for (int i = 0; i < k; ++i)
+        if (msg[i]) {
+          int pos = k - 1 - i;
+          data[pos / 8] |= (1 << (7 - (pos % 8)));
+        }
+      std::vector<uint8_t> ecc(code.get_ecc_bytes());
+      code.encode(data.data(), data.size(), ecc.data());
+      for (int i = 0; i < c[0] - k; ++i) {
+        ASSERT_EQ(cw[i], (ecc[i / 8] >> (i % 8)) & 1,
+                  "Byte/bit encoder mismatch N=" + std::to_string(c[0]));
+      }
+    }
+  }
+  PASS("Byte encoder matches bit-serial encoder");
+
+  // 6. Caller-owned Workspace overloads
+  {
+    lite::LiteBCH code(1023, 8);
+    lite::LiteBCH::Workspace ws(code);
+    int k = code.get_K();
+    std::vector<uint8_t> data((k + 7) / 8);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = (uint8_t)(i * 37 + 11);
+    std::vector<uint8_t> ecc(code.get_ecc_bytes());
+    std::vector<uint8_t> ecc_ws(code.get_ecc_bytes());
+    code.encode(data.data(), data.size(), ecc.data());
+    code.encode(data.data(), data.size(), ecc_ws.data(), ws);
+    ASSERT_TRUE(ecc == ecc_ws, "Workspace encode mismatch");
+
+    std::vector<uint8_t> rx = data;
+    rx[3] ^= 0x10;
+    rx[40] ^= 0x81;
+    ecc_ws[1] ^= 0x04;
+    int count = code.decode(rx.data(), rx.size(), ecc_ws.data(), ws);
+    ASSERT_EQ(4, count, "Workspace decode error count");
+    ASSERT_TRUE(rx == data && ecc_ws == ecc, "Workspace decode content");
+  }
+  PASS("Workspace encode/decode");
+
+  // 7. Two contexts sharing one immutable code
+  {
+    auto shared = std::make_shared<const lite::LiteBCHCode>(255, 6);
+    lite::LiteBCH a(shared), b(shared);
+    ASSERT_TRUE(a.get_code() == b.get_code(), "Contexts do not share code");
+    ASSERT_EQ(shared->get_K(), a.get_K(), "Shared code K");
+
+    std::vector<uint8_t> data((a.get_K() + 7) / 8, 0x5a);
+    std::vector<uint8_t> ecc(a.get_ecc_bytes());
+    a.encode(data.data(), data.size(), ecc.data());
+
+    std::vector<uint8_t> rx_a = data, rx_b = data;
+    std::vector<uint8_t> ecc_a = ecc, ecc_b = ecc;
+    rx_a[0] ^= 0x01;
+    rx_b[5] ^= 0x22;
+    ASSERT_EQ(1, a.decode(rx_a.data(), rx_a.size(), ecc_a.data()),
+              "Shared code decode (a)");
+    ASSERT_EQ(2, b.decode(rx_b.data(), rx_b.size(), ecc_b.data()),
+              "Shared code decode (b)");
+    ASSERT_TRUE(rx_a == data && rx_b == data, "Shared code content");
+  }
+  PASS("Shared LiteBCHCode");
+
+  // 8. Batch encode/decode over strided buffers
+  {
+    lite::LiteBCH code(1023, 10);
+    const size_t count = 16;
+    const size_t len = (code.get_K() + 7) / 8;
+    const size_t stride = len + 3; // padded records
+    const size_t ecc_len = code.get_ecc_bytes();
+    const size_t ecc_stride = ecc_len + 1;
+    std::vector<uint8_t> data(count * stride), ecc(count * ecc_stride);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = (uint8_t)(i * 131 + 7);
+    code.encode_batch(data.data(), len, stride, count, ecc.data(), ecc_stride);
+
+    std::vector<uint8_t> single(ecc_len);
+    for (size_t c = 0; c < count; ++c) {
+      code.encode(&data[c * stride], len, single.data());
+      ASSERT_TRUE(std::equal(single.begin(), single.end(),
+                             ecc.begin() + c * ecc_stride),
+                  "Batch encode mismatch at " + std::to_string(c));
+    }
+
+    std::vector<uint8_t> rx = data;
+    for (size_t c = 0; c < count; ++c)
+      for (size_t e = 0; e < c % 5; ++e)
+        rx[c * stride + e * 17] ^= 0x08;
+    rx[3 * stride + 1] ^= 0xff; // 12 extra errors: 15 total > t
+    rx[3 * stride + 2] ^= 0x0f;
+    std::vector<int> errors(count);
+    size_t failed = code.decode_batch(rx.data(), len, stride, count, ecc.data(),
+                                      ecc_stride, errors.data());
+    ASSERT_EQ((size_t)1, failed, "Batch decode failure count");
+    for (size_t c = 0; c < count; ++c) {
+      if (c == 3) {
+        ASSERT_EQ(-1, errors[c], "Batch decode uncorrectable codeword");
+        continue;
+      }
+      ASSERT_EQ((int)(c % 5), errors[c], "Batch decode error count");
+      ASSERT_TRUE(std::equal(rx.begin() + c * stride,
+                             rx.begin() + c * stride + len,
+                             data.begin() + c * stride),
+                  "Batch decode content at " + std::to_string(c));
+    }
+  }
+  PASS("Batch encode/decode");
+
+  // 9. Parallel batch decode matches the serial batch decode
+  {
+    auto shared = std::make_shared<const lite::LiteBCHCode>(1023, 12);
+    const size_t count = 203;
+    const size_t len = (shared->get_K() + 7) / 8;
+    const size_t ecc_len = shared->get_ecc_bytes();
+    std::vector<uint8_t> data(count * len), ecc(count * ecc_len);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = (uint8_t)(i * 29 + (i >> 7));
+
+    lite::ParallelBCH par(shared, 4, 5);
+    ASSERT_EQ(4u, par.get_threads(), "ParallelBCH thread count");
+    par.encode_batch(data.data(), len, len, count, ecc.data(), ecc_len);
+    lite::LiteBCH serial(shared);
+    std::vector<uint8_t> ecc_serial(count * ecc_len);
+    serial.encode_batch(data.data(), len, len, count, ecc_serial.data(),
+                        ecc_len);
+    ASSERT_TRUE(ecc == ecc_serial, "Parallel encode mismatch");
+
+    // Uneven error load: some codewords clean, some up to t errors.
+    std::vector<uint8_t> rx = data;
+    for (size_t c = 0; c < count; ++c)
+      for (size_t e = 0; e < (c * 7) % 13; ++e)
+        rx[c * len + e * 9] ^= 0x40;
+    std::vector<int> errors(count, -2);
+    size_t failed = par.decode_batch(rx.data(), len, len, count, ecc.data(),
+                                     ecc_len, errors.data());
+    ASSERT_EQ((size_t)0, failed, "Parallel decode failures");
+    for (size_t c = 0; c < count; ++c)
+      ASSERT_EQ((int)((c * 7) % 13), errors[c], "Parallel decode count");
+    ASSERT_TRUE(rx == data, "Parallel decode content");
+  }
+  PASS("Parallel batch decode");
+
+  // 10. Chien search (bounded window, early exit, SIMD kernels where
+  // enabled) vs. the full scalar scan of the bit-serial decoder
+  {
+    const int cfg[][2] = {{255, 8}, {1023, 8}, {8191, 12}};
+    for (const auto &c : cfg) {
+      lite::LiteBCH code(c[0], c[1]);
+      const int n = c[0], tc = c[1];
+      const int k = code.get_K(), r = n - k;
+      std::vector<int> msg(k);
+      for (int i = 0; i < k; ++i)
+        msg[i] = ((i * 11 + 3) % 7) < 3;
+      std::vector<int> cw = code.encode(msg);
+
+      // Codeword degree d: ECC bit d below r, else data bit n - 1 - d
+      std::vector<uint8_t> data((k + 7) / 8, 0), ecc(code.get_ecc_bytes(), 0);
+      auto flip = [&](std::vector<uint8_t> &dat, std::vector<uint8_t> &ec,
+                      int d) {
+        if (d < r) {
+          ec[d / 8] ^= (uint8_t)(1 << (d % 8));
+        } else {
+          int p = n - 1 - d;
+          dat[p / 8] ^= (uint8_t)(0x80 >> (p % 8));
+        }
+      };
+      for (int d = 0; d < n; ++d)
+        if (cw[d])
+          flip(data, ecc, d);
+
+      std::vector<std::vector<int>> patterns;
+      patterns.push_back({0, n - 1});          // both ends of the window
+      patterns.push_back({0, 1, n - 2, n - 1}); // ends, adjacent roots
+      std::vector<int> high, spread, over;
+      for (int j = 0; j < tc; ++j) {
+        high.push_back(n - 1 - j); // all roots in the first step: early exit
+        spread.push_back((j * 97 + 5) % n);
+      }
+      for (int j = 0; j <= tc; ++j)
+        over.push_back((j * 131 + 17) % n); // t + 1 errors
+      patterns.push_back(high);
+      patterns.push_back(spread);
+      patterns.push_back(over);
+
+      for (size_t pi = 0; pi < patterns.size(); ++pi) {
+        const std::vector<int> &pat = patterns[pi];
+        const std::string where =
+            " N=" + std::to_string(n) + " pattern " + std::to_string(pi);
+        std::vector<uint8_t> rx = data, rx_ecc = ecc;
+        std::vector<int> rx_cw = cw;
+        for (int d : pat) {
+          flip(rx, rx_ecc, d);
+          rx_cw[d] ^= 1;
+        }
+        std::vector<int> out;
+        bool ok = code.decode(rx_cw, out);
+        int count = code.decode(rx.data(), rx.size(), rx_ecc.data());
+        ASSERT_EQ(ok ? (int)pat.size() : -1, count,
+                  "Chien search vs. scalar scan" + where);
+        if ((int)pat.size() <= tc) {
+          ASSERT_TRUE(ok && out == msg, "Scalar scan reference" + where);
+          ASSERT_TRUE(rx == data && rx_ecc == ecc,
+                      "Chien search content" + where);
+        } else {
+          ASSERT_EQ(-1, count, "Chien search uncorrectable" + where);
+        }
+      }
+    }
+  }
+  PASS("Chien search");
+  // 11. Low-degree locators (closed-form roots) vs. Chien search
+  {
+    const int cfg[][2] = {{255, 8}, {2047, 6}, {8191, 10}};
+    for (const auto &c : cfg) {
+      lite::LiteBCH code(c[0], c[1]);
+      const int k = code.get_K();
+      const size_t len = (k + 7) / 8;
+      std::vector<uint8_t> data(len), ecc(code.get_ecc_bytes());
+      for (size_t i = 0; i < len; ++i)
+        data[i] = (uint8_t)(i * 73 + 5);
+      code.encode(data.data(), len, ecc.data());
+
+      // 1..6 errors, first and last data bit plus ECC bit 0 included
+      const int pos[] = {0, k - 1, k, 301, 77, 1024};
+      for (int ne = 1; ne <= 6; ++ne) {
+        std::vector<uint8_t> rx = data, rx_ecc = ecc;
+        for (int e = 0; e < ne; ++e) {
+          int p = pos[e] % (k + 8);
+          if (p < k)
+            rx[p / 8] ^= (uint8_t)(0x80 >> (p % 8));
+          else
+            rx_ecc[0] ^= (uint8_t)(1 << (p - k));
+        }
+        ASSERT_EQ(ne, code.decode(rx.data(), len, rx_ecc.data()),
+                  "Low-degree decode count N=" + std::to_string(c[0]));
+        ASSERT_TRUE(rx == data && rx_ecc == ecc,
+                    "Low-degree decode content N=" + std::to_string(c[0]));
+      }
+    }
+  }
+  PASS("Low-degree root finding");
+
+  // 12. Direct syndromes: zero on codewords, linear in the error pattern
+  {
+    lite::LiteBCHCode code(4095, 20);
+    lite::LiteBCHCode::Workspace ws(code);
+    const size_t len = (code.get_K() + 7) / 8;
+    const int t2 = 2 * code.get_t();
+    std::vector<uint8_t> data(len), ecc(code.get_ecc_bytes());
+    for (size_t i = 0; i < len; ++i)
+      data[i] = (uint8_t)(i * 131 + 17);
+    code.encode(data.data(), len, ecc.data(), ws);
+    std::vector<int> s(t2 + 1), s_err(t2 + 1);
+    ASSERT_TRUE(!code.syndromes(data.data(), len, ecc.data(), s.data(), ws),
+                "Syndromes of a codeword");
+
+    // Same error pattern on the zero codeword
+    std::vector<uint8_t> zero(len), zero_ecc(ecc.size());
+    const size_t err_bytes[] = {0, 9, 200, len - 1};
+    for (size_t b : err_bytes) {
+      data[b] ^= 0x12;
+      zero[b] ^= 0x12;
+    }
+    ecc[3] ^= 0x80;
+    zero_ecc[3] ^= 0x80;
+    ASSERT_TRUE(code.syndromes(data.data(), len, ecc.data(), s.data(), ws),
+                "Syndromes with errors");
+    code.syndromes(zero.data(), len, zero_ecc.data(), s_err.data(), ws);
+    ASSERT_TRUE(s == s_err, "Syndromes depend only on the error pattern");
+    int corrected = code.decode(data.data(), len, ecc.data(), ws);
+    ASSERT_EQ(9, corrected, "Decode after syndromes");
+  }
+  PASS("Direct syndromes");
+
+#ifdef LITEBCH_STATIC_CODEC
+  // 13. StaticBCH<M, T> produces the same ECC and corrections as LiteBCH
+  {
+    lite::StaticBCH<10, 16> sbch;
+    lite::LiteBCH rbch(1023, 16);
+    static_assert(lite::StaticBCH<10, 16>::K == 863, "StaticBCH<10, 16>::K");
+    ASSERT_EQ(rbch.get_K(), sbch.get_K(), "StaticBCH K");
+    ASSERT_EQ(rbch.get_ecc_bytes(), sbch.get_ecc_bytes(), "StaticBCH ecc");
+
+    const size_t len = sbch.data_bytes;
+    std::vector<uint8_t> data(len), ecc(sbch.ecc_bytes), ref(sbch.ecc_bytes);
+    for (size_t i = 0; i < len; ++i)
+      data[i] = (uint8_t)(i * 29 + 3);
+    data[len - 1] &= (uint8_t)(0xff << (8 * len - sbch.K));
+    sbch.encode(data.data(), len, ecc.data());
+    rbch.encode(data.data(), len, ref.data());
+    ASSERT_TRUE(ecc == ref, "StaticBCH ECC matches LiteBCH");
+
+    // 0, 1, 2, 9 and 16 errors over data and ECC; 17 is beyond t
+    const int pos[] = {0,   5,   862, 863, 1022, 100, 200, 300, 400,
+                       401, 402, 500, 600, 700,  800, 900, 950};
+    const int counts[] = {0, 1, 2, 9, 16, 17};
+    for (int ne : counts) {
+      std::vector<uint8_t> rx = data, rx_ecc = ecc;
+      for (int e = 0; e < ne; ++e) {
+        int p = pos[e];
+        if (p < sbch.K)
+          rx[p / 8] ^= (uint8_t)(0x80 >> (p % 8));
+        else
+          rx_ecc[(p - sbch.K) / 8] ^= (uint8_t)(1 << ((p - sbch.K) % 8));
+      }
+      std::vector<uint8_t> rt = rx, rt_ecc = rx_ecc;
+      int res = sbch.decode(rx.data(), len, rx_ecc.data());
+      int expected = rbch.decode(rt.data(), len, rt_ecc.data());
+      ASSERT_EQ(expected, res, "StaticBCH decode, errors=" + std::to_string(ne));
+      if (ne <= 16)
+        ASSERT_TRUE(rx == data && rx_ecc == ecc,
+                    "StaticBCH correction, errors=" + std::to_string(ne));
+    }
+  }
+  PASS("StaticBCH matches LiteBCH");
+#endif
+
+  // 14. Code cache and table serialization
+  {
+    auto a = lite::LiteBCHCode::get(8191, 12);
+    auto b = lite::LiteBCHCode::get(8191, 12,
+                                    lite::LiteBCHCode::default_polynomial(13));
+    ASSERT_TRUE(a == b, "Cache returns one instance per (N, t, p)");
+    ASSERT_TRUE(a != lite::LiteBCHCode::get(8191, 13), "Cache key includes t");
+
+    std::vector<uint8_t> blob = a->serialize();
+    auto loaded = lite::LiteBCHCode::deserialize(blob.data(), blob.size());
+    ASSERT_TRUE(loaded->serialize() == blob, "Blob round trip");
+
+    lite::LiteBCH orig(a), copy(loaded);
+    const size_t len = (a->get_K() + 7) / 8;
+    std::vector<uint8_t> data(len), ecc(a->get_ecc_bytes()), ecc2(ecc.size());
+    for (size_t i = 0; i < len; ++i)
+      data[i] = (uint8_t)(i * 7 + 1);
+    orig.encode(data.data(), len, ecc.data());
+    copy.encode(data.data(), len, ecc2.data());
+    ASSERT_TRUE(ecc == ecc2, "Deserialized code encodes identically");
+    data[3] ^= 0x10;
+    data[700] ^= 0x01;
+    ecc2[0] ^= 0x04;
+    int corrected = copy.decode(data.data(), len, ecc2.data());
+    ASSERT_EQ(3, corrected, "Deserialized code decodes");
+    ASSERT_TRUE(ecc == ecc2, "Deserialized code corrects ECC");
+
+    lite::LiteBCHCode::clear_cache();
+    lite::LiteBCHCode::preload(loaded);
+    ASSERT_TRUE(lite::LiteBCHCode::get(8191, 12) == loaded, "Preloaded code");
+
+    bool threw = false;
+    blob[blob.size() / 2] ^= 1;
+    try {
+      lite::LiteBCHCode::deserialize(blob.data(), blob.size());
+    } catch (const std::invalid_argument &) {
+      threw = true;
+    }
+    ASSERT_TRUE(threw, "Corrupted blob is rejected");
+
+    // 2t roots need 2t distinct non-zero field elements
+    threw = false;
+    try {
+      lite::LiteBCHCode bad(31, 16);
+    } catch (const std::invalid_argument &) {
+      threw = true;
+    }
+    ASSERT_TRUE(threw, "t above (N - 1) / 2 is rejected");
+  }
+  PASS("Code cache and serialization");
+
+  // 15. Shortened codes: a len-byte message encodes like the full-length
+  // message with leading zeros, and decoding only looks inside its window
+  {
+    lite::LiteBCH code(8191, 8);
+    const int K = code.get_K();
+    const int r = code.get_N() - K;
+    const size_t full = (K + 7) / 8;
+    const size_t lens[] = {1, 64, 512, 1000};
+    for (size_t len : lens) {
+      const int bits = 8 * (int)len;
+      std::vector<uint8_t> data(len), ecc(code.get_ecc_bytes()),
+          ref(ecc.size()), padded(full, 0);
+      for (size_t i = 0; i < len; ++i)
+        data[i] = (uint8_t)(i * 53 + 11);
+      const int lead = K - bits;
+      for (int q = 0; q < bits; ++q)
+        if ((data[q / 8] >> (7 - q % 8)) & 1)
+          padded[(lead + q) / 8] |= (uint8_t)(0x80 >> ((lead + q) % 8));
+      code.encode(data.data(), len, ecc.data());
+      code.encode(padded.data(), full, ref.data());
+      ASSERT_TRUE(ecc == ref, "Shortened ECC, len=" + std::to_string(len));
+
+      // t errors spread over the data and ECC bits
+      std::vector<uint8_t> rx = data, rx_ecc = ecc;
+      for (int e = 0; e < 8; ++e) {
+        int p = e * ((bits + r) / 8);
+        if (p < bits)
+          rx[p / 8] ^= (uint8_t)(0x80 >> (p % 8));
+        else
+          rx_ecc[(p - bits) / 8] ^= (uint8_t)(1 << ((p - bits) % 8));
+      }
+      int corrected = code.decode(rx.data(), len, rx_ecc.data());
+      ASSERT_EQ(8, corrected, "Shortened decode, len=" + std::to_string(len));
+      ASSERT_TRUE(rx == data && rx_ecc == ecc,
+                  "Shortened correction, len=" + std::to_string(len));
+#ifdef LITEBCH_STATIC_CODEC
+      lite::StaticBCH<13, 8> sbch;
+      std::vector<uint8_t> s_ecc(ecc.size());
+      sbch.encode(data.data(), len, s_ecc.data());
+      ASSERT_TRUE(s_ecc == ecc, "StaticBCH shortened ECC");
+      rx[0] ^= 0x40;
+      s_ecc[1] ^= 0x02;
+      ASSERT_EQ(2, sbch.decode(rx.data(), len, s_ecc.data()),
+                "StaticBCH shortened decode");
+      ASSERT_TRUE(rx == data && s_ecc == ecc, "StaticBCH shortened correction");
+#endif
+    }
+
+    bool threw = false;
+    std::vector<uint8_t> data(full + 1), ecc(code.get_ecc_bytes());
+    try {
+      code.encode(data.data(), full + 1, ecc.data());
+    } catch (const std::invalid_argument &) {
+      threw = true;
+    }
+    ASSERT_TRUE(threw, "len above (K + 7) / 8 is rejected");
+  }
+  PASS("Shortened codes");
+
+  // 16. Streaming and scatter-gather encoding match one-shot encode()
+  {
+    struct Frag {
+      const void *iov_base;
+      size_t iov_len;
+    };
+    lite::LiteBCH code(8191, 8);
+    const size_t full = (code.get_K() + 7) / 8;
+    std::vector<uint8_t> data(full);
+    for (size_t i = 0; i < full; ++i)
+      data[i] = (uint8_t)(i * 97 + 5);
+    const size_t lens[] = {1, 7, 300, full - 1, full};
+    const size_t steps[] = {1, 3, 4, 13, 256};
+    lite::LiteBCH::EncodeState st;
+    for (size_t len : lens) {
+      std::vector<uint8_t> ref(code.get_ecc_bytes()), ecc(ref.size());
+      code.encode(data.data(), len, ref.data());
+      for (size_t step : steps) {
+        code.encode_begin(st);
+        for (size_t off = 0; off < len; off += step)
+          code.encode_update(st, data.data() + off, std::min(step, len - off));
+        ASSERT_EQ(len, st.size(), "Streamed byte count");
+        code.encode_final(st, ecc.data());
+        ASSERT_TRUE(ecc == ref, "Streamed ECC, len=" + std::to_string(len) +
+                                    " step=" + std::to_string(step));
+      }
+      Frag iov[3] = {{data.data(), len / 3},
+                     {data.data() + len / 3, 0},
+                     {data.data() + len / 3, len - len / 3}};
+      std::fill(ecc.begin(), ecc.end(), 0);
+      code.encodev(iov, 3, ecc.data());
+      ASSERT_TRUE(ecc == ref, "encodev ECC, len=" + std::to_string(len));
+    }
+
+    bool threw = false;
+    code.encode_begin(st);
+    code.encode_update(st, data.data(), full);
+    try {
+      code.encode_update(st, data.data(), 1);
+    } catch (const std::invalid_argument &) {
+      threw = true;
+    }
+    ASSERT_TRUE(threw, "Streaming past (K + 7) / 8 bytes is rejected");
+  }
+  PASS("Streaming encoder");
+
+  // 17. check(): detection only, buffers and decoder state untouched
+  {
+    auto shared = lite::LiteBCHCode::get(8191, 8);
+    lite::LiteBCH code(shared);
+    const size_t len = 512, count = 64;
+    const size_t ecc_bytes = code.get_ecc_bytes();
+    std::vector<uint8_t> data(len * count), ecc(ecc_bytes * count);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = (uint8_t)(i * 29 + 3);
+    code.encode_batch(data.data(), len, len, count, ecc.data(), ecc_bytes);
+    ASSERT_TRUE(code.check(data.data(), len, ecc.data()), "Clean word passes");
+
+    // Every single-bit flip of one codeword is detected; bits above
+    // ecc_bits in the last ECC byte are padding and ignored.
+    const int r = code.get_N() - code.get_K();
+    bool all_detected = true;
+    for (int q = 0; q < 8 * (int)len + r; q += 7) {
+      uint8_t *byte = q < 8 * (int)len ? &data[q / 8]
+                                       : &ecc[(q - 8 * len) / 8];
+      uint8_t bit = q < 8 * (int)len ? (uint8_t)(0x80 >> (q % 8))
+                                     : (uint8_t)(1 << ((q - 8 * len) % 8));
+      *byte ^= bit;
+      all_detected &= !code.check(data.data(), len, ecc.data());
+      *byte ^= bit;
+    }
+    ASSERT_TRUE(all_detected, "Single-bit errors are detected");
+    if (r % 8) {
+      ecc[ecc_bytes - 1] ^= 0x80;
+      ASSERT_TRUE(code.check(data.data(), len, ecc.data()),
+                  "ECC padding bits are ignored");
+      ecc[ecc_bytes - 1] ^= 0x80;
+    }
+
+    const size_t bad[] = {3, 17, 18, 63};
+    for (size_t c : bad)
+      data[c * len + c] ^= 0x10;
+    const std::vector<uint8_t> rx = data, rx_ecc = ecc;
+    std::vector<char> expect(count, 1);
+    for (size_t c : bad)
+      expect[c] = 0;
+
+    bool valid[count];
+    ASSERT_EQ(4, (int)code.check_batch(data.data(), len, len, count,
+                                       ecc.data(), ecc_bytes, valid),
+              "check_batch count");
+    bool match = true;
+    for (size_t c = 0; c < count; ++c)
+      match &= valid[c] == (bool)expect[c];
+    ASSERT_TRUE(match, "check_batch flags");
+
+    lite::ParallelBCH pbch(shared, 4, 8);
+    std::fill(valid, valid + count, true);
+    ASSERT_EQ(4, (int)pbch.check_batch(data.data(), len, len, count,
+                                       ecc.data(), ecc_bytes, valid),
+              "ParallelBCH check_batch count");
+    match = true;
+    for (size_t c = 0; c < count; ++c)
+      match &= valid[c] == (bool)expect[c];
+    ASSERT_TRUE(match, "ParallelBCH check_batch flags");
+    ASSERT_TRUE(data == rx && ecc == rx_ecc, "check leaves buffers intact");
+
+    // Only the flagged words go through decode()
+    for (size_t c = 0; c < count; ++c)
+      if (!valid[c])
+        code.decode(&data[c * len], len, &ecc[c * ecc_bytes]);
+    ASSERT_EQ(0, (int)code.check_batch(data.data(), len, len, count,
+                                       ecc.data(), ecc_bytes),
+              "All words valid after decoding the flagged ones");
+  }
+  PASS("Error detection");
+
+  // 18. encode_batch (lockstep SIMD groups plus a scalar tail) matches
+  // encode() for full and shortened lengths and padded strides
+  {
+    const int codes[][2] = {{1023, 8}, {8191, 8}, {8191, 24}, {32767, 40}};
+    for (const auto &nt : codes) {
+      lite::LiteBCH code(nt[0], nt[1]);
+      const size_t full = (code.get_K() + 7) / 8;
+      const size_t eb = code.get_ecc_bytes();
+      const size_t lens[] = {16, 100, full};
+      for (size_t len : lens) {
+        const size_t count = 133, stride = len + 3, ecc_stride = eb + 1;
+        std::vector<uint8_t> data(count * stride), ecc(count * ecc_stride),
+            ref(eb);
+        for (size_t i = 0; i < data.size(); ++i)
+          data[i] = (uint8_t)(i * 131 + len);
+        code.encode_batch(data.data(), len, stride, count, ecc.data(),
+                          ecc_stride);
+        bool match = true;
+        for (size_t c = 0; c < count; ++c) {
+          code.encode(&data[c * stride], len, ref.data());
+          match &= std::equal(ref.begin(), ref.end(), &ecc[c * ecc_stride]);
+        }
+        ASSERT_TRUE(match, "encode_batch, N=" + std::to_string(nt[0]) +
+                               " t=" + std::to_string(nt[1]) +
+                               " len=" + std::to_string(len));
+      }
+    }
+  }
+  PASS("Batch encoding");
+
+  // 19. The byte encoders (carry-less multiply where the CPU has it, slice-by-4
+  // otherwise) match the bit-serial encoder for remainders below, at and
+  // above 64-bit word boundaries
+  {
+    const int codes[][2] = {{1023, 3},  {255, 8},   {8191, 5},
+                            {65535, 8}, {32767, 100}};
+    for (const auto &nt : codes) {
+      lite::LiteBCH code(nt[0], nt[1]);
+      code.set_reference_mode(lite::ReferenceMode::BitSerial);
+      const int K = code.get_K();
+      const int r = code.get_N() - K;
+      std::vector<int> msg(K);
+      std::vector<uint8_t> data((K + 7) / 8, 0), ecc(code.get_ecc_bytes());
+      for (int i = 0; i < K; ++i) {
+        msg[i] = (i * 7 + i / 5) % 3 == 0;
+        int q = K - 1 - i; // stream position of message bit i
+        if (msg[i])
+          data[q / 8] |= (uint8_t)(0x80 >> (q % 8));
+      }
+      std::vector<int> cw = code.encode(msg);
+      code.encode(data.data(), data.size(), ecc.data());
+      bool match = true;
+      for (int j = 0; j < r; ++j)
+        match &= ((ecc[j / 8] >> (j % 8)) & 1) == cw[j];
+      ASSERT_TRUE(match, "Byte encoder vs bit-serial, N=" +
+                             std::to_string(nt[0]) +
+                             " t=" + std::to_string(nt[1]));
+    }
+  }
+  PASS("Encoder layouts");
+
+  // 20. Every usable backend pair gives the same ECC, corrections and
+  // verdicts; one Workspace is reused across the switches
+  {
+    const int codes[][2] = {{8191, 8}, {1023, 24}};
+    for (const auto &nt : codes) {
+      auto code = lite::LiteBCHCode::get(nt[0], nt[1]);
+      lite::LiteBCHCode::Workspace ws(*code);
+      const size_t len = (code->get_K() + 7) / 8;
+      const size_t eb = code->get_ecc_bytes();
+      const size_t count = 70;
+      std::vector<uint8_t> data(count * len);
+      for (size_t i = 0; i < data.size(); ++i)
+        data[i] = (uint8_t)(i * 131 + i / 7);
+      std::vector<uint8_t> ref_ecc, ref_out;
+      std::vector<int> ref_err;
+
+      for (const auto &vec : lite::vector_backends()) {
+        for (const auto &enc : lite::encode_backends()) {
+          lite::set_vector_backend(vec);
+          lite::set_encode_backend(enc);
+          ASSERT_EQ(lite::get_vector_backend(), vec, "Vector backend bound");
+          ASSERT_EQ(lite::get_encode_backend(), enc, "Encode backend bound");
+          std::vector<uint8_t> ecc(count * eb);
+          code->encode_batch(data.data(), len, len, count, ecc.data(), eb, ws);
+
+          std::vector<uint8_t> out = data;
+          // c % (t + 2) errors per codeword, none in the padded last byte
+          for (size_t c = 0; c < count; ++c)
+            for (size_t e = 0; e < c % (nt[1] + 2); ++e)
+              out[c * len + (e * 37 + c) % (len - 1)] ^=
+                  (uint8_t)(1 << (e % 8));
+          std::vector<int> err(count);
+          code->decode_batch(out.data(), len, len, count, ecc.data(), eb,
+                             err.data(), ws);
+          if (ref_ecc.empty()) {
+            ref_ecc = ecc;
+            ref_out = out;
+            ref_err = err;
+          }
+          const std::string tag = vec + "/" + enc;
+          ASSERT_TRUE(ecc == ref_ecc, "Same ECC on " + tag);
+          ASSERT_TRUE(out == ref_out, "Same corrections on " + tag);
+          ASSERT_TRUE(err == ref_err, "Same error counts on " + tag);
+          for (size_t c = 0; c < count; ++c)
+            if ((int)(c % (nt[1] + 2)) <= nt[1])
+              ASSERT_TRUE(std::equal(out.begin() + c * len,
+                                     out.begin() + (c + 1) * len,
+                                     data.begin() + c * len),
+                          "Corrected codeword on " + tag);
+        }
+      }
+    }
+    bool thrown = false;
+    try {
+      lite::set_vector_backend("mmx");
+    } catch (const std::invalid_argument &) {
+      thrown = true;
+    }
+    ASSERT_TRUE(thrown, "Unknown backend throws");
+    lite::set_vector_backend("auto");
+    lite::set_encode_backend("auto");
+    ASSERT_EQ(lite::get_vector_backend(), lite::vector_backends()[0],
+              "auto binds the best vector backend");
+    ASSERT_EQ(lite::get_encode_backend(), lite::encode_backends()[0],
+              "auto binds the best encode backend");
+  }
+  PASS("Backend selection");
+
+  // 21. Bit-per-element API and the aff3ct shim match the bit-serial encoder
+  // and decode in place, on every vector backend (pack / unpack kernels)
+  {
+    const int codes[][2] = {{255, 4}, {1023, 8}, {8191, 13}};
+    for (const auto &vec : lite::vector_backends()) {
+      lite::set_vector_backend(vec);
+      for (const auto &nt : codes) {
+        lite::LiteBCH bch(nt[0], nt[1]);
+        const int K = bch.get_K(), N = bch.get_N(), t = nt[1];
+        std::vector<int> msg(K);
+        for (int i = 0; i < K; ++i)
+          msg[i] = (i * 13 + i / 3) % 5 < 2;
+        const std::vector<int> ref =
+            bch.get_code()->encode(msg, lite::ReferenceMode::BitSerial);
+        const std::string tag = vec + " N=" + std::to_string(N);
+
+        std::vector<int> cw(N, 7);
+        bch.encode_bits(msg.data(), cw.data());
+        ASSERT_TRUE(cw == ref, "encode_bits " + tag);
+        std::copy(msg.begin(), msg.end(), cw.begin() + (N - K));
+        bch.encode_bits(cw.data() + (N - K), cw.data());
+        ASSERT_TRUE(cw == ref, "encode_bits in place " + tag);
+
+        for (int e = 0; e < t; ++e) // parity, message head and message tail
+          cw[(e * 97 + 3 * e) % N] ^= 1;
+        std::vector<int> out(K, 7);
+        ASSERT_TRUE(bch.decode_bits(cw.data(), out.data()) >= 0,
+                    "decode_bits " + tag);
+        ASSERT_TRUE(out == msg, "decode_bits message " + tag);
+        for (int e = 0; e < 2 * t + 1; ++e)
+          cw[N - 1 - e] ^= 1;
+        if (bch.decode_bits(cw.data(), out.data()) < 0)
+          ASSERT_TRUE(std::equal(out.begin(), out.end(), cw.begin() + (N - K)),
+                      "decode_bits failure keeps the received message " + tag);
+
+        aff3ct::tools::BCH_polynomial_generator<int> gen(N, t);
+        aff3ct::module::Encoder_BCH<int> enc(K, N, gen);
+        aff3ct::module::Decoder_BCH_std<int> dec(K, N, gen);
+        std::vector<int> x(N), v(K);
+        enc.encode(msg, x);
+        ASSERT_TRUE(x == ref, "Encoder_BCH " + tag);
+        x[0] ^= 1;
+        x[N - 1] ^= 1;
+        ASSERT_EQ(dec.decode_hiho(x, v), 0, "Decoder_BCH_std " + tag);
+        ASSERT_TRUE(v == msg, "Decoder_BCH_std message " + tag);
+
+        // Other bit types go through a conversion buffer
+        aff3ct::tools::BCH_polynomial_generator<int8_t> gen8(N, t);
+        aff3ct::module::Encoder_BCH<int8_t> enc8(K, N, gen8);
+        aff3ct::module::Decoder_BCH_std<int8_t> dec8(K, N, gen8);
+        std::vector<int8_t> msg8(msg.begin(), msg.end()), x8, v8;
+        enc8.encode(msg8, x8);
+        ASSERT_TRUE(std::equal(x8.begin(), x8.end(), ref.begin()),
+                    "Encoder_BCH<int8_t> " + tag);
+        x8[K / 2] ^= 1;
+        ASSERT_EQ(dec8.decode_hiho(x8, v8), 0,
+                  "Decoder_BCH_std<int8_t> " + tag);
+        ASSERT_TRUE(v8 == msg8, "Decoder_BCH_std<int8_t> message " + tag);
+      }
+    }
+    lite::set_vector_backend("auto");
+  }
+  PASS("Bit-per-element API");
+
+  // 22. std::vector API on the byte engine vs the bit-serial reference mode,
+  // and the uint8_t bit API vs the int one, on every vector backend
+  {
+    const int codes[][2] = {{31, 3}, {511, 7}, {4095, 20}};
+    for (const auto &vec : lite::vector_backends()) {
+      lite::set_vector_backend(vec);
+      for (const auto &nt : codes) {
+        lite::LiteBCH fast(nt[0], nt[1]);
+        lite::LiteBCH ref(fast.get_code());
+        ref.set_reference_mode(lite::ReferenceMode::BitSerial);
+        ASSERT_TRUE(fast.get_reference_mode() == lite::ReferenceMode::Off,
+                    "Fast engine by default");
+        const int K = fast.get_K(), N = fast.get_N(), t = nt[1];
+        const std::string tag = vec + " N=" + std::to_string(N);
+        for (int trial = 0; trial < 8; ++trial) {
+          std::vector<int> msg(K);
+          for (int i = 0; i < K; ++i)
+            msg[i] = (i * (trial + 3) + i / 7) % 3 == 0;
+          std::vector<int> cw = fast.encode(msg);
+          ASSERT_TRUE(cw == ref.encode(msg), "Vector encode " + tag);
+
+          const int n_err = trial % (t + 1);
+          for (int e = 0; e < n_err; ++e)
+            cw[(e * 131 + trial * 17) % N] ^= 1;
+          std::vector<int> dec_fast, dec_ref;
+          ASSERT_TRUE(fast.decode(cw, dec_fast), "Vector decode " + tag);
+          ASSERT_TRUE(ref.decode(cw, dec_ref), "Reference decode " + tag);
+          ASSERT_TRUE(dec_fast == msg && dec_ref == msg,
+                      "Vector decode message " + tag);
+
+          std::vector<uint8_t> msg8(msg.begin(), msg.end()), cw8(N), out8(K);
+          fast.encode_bits(msg8.data(), cw8.data());
+          const std::vector<int> ref_cw = ref.encode(msg);
+          ASSERT_TRUE(std::equal(cw8.begin(), cw8.end(), ref_cw.begin()),
+                      "uint8_t encode_bits " + tag);
+          std::vector<uint8_t> rx8(cw.begin(), cw.end());
+          ASSERT_EQ(fast.decode_bits(rx8.data(), out8.data()), n_err,
+                    "uint8_t decode_bits " + tag);
+          ASSERT_TRUE(out8 == msg8, "uint8_t decode_bits message " + tag);
+        }
+      }
+    }
+    lite::set_vector_backend("auto");
+  }
+  PASS("Vector API engines");
+
+  // 23. Berlekamp-Massey: every weight up to t is corrected, and beyond t
+  // the decoder either fails or lands on a valid codeword (large m and t)
+  {
+    const int codes[][2] = {{8191, 40}, {32767, 64}};
+    for (const auto &nt : codes) {
+      lite::LiteBCH code(nt[0], nt[1]);
+      const int t = nt[1];
+      const size_t len = 768;
+      const std::string tag = "N=" + std::to_string(nt[0]);
+      std::vector<uint8_t> data(len), ecc(code.get_ecc_bytes());
+      for (size_t i = 0; i < len; ++i)
+        data[i] = (uint8_t)(i * 97 + 13);
+      code.encode(data.data(), len, ecc.data());
+      const std::vector<uint8_t> orig = data;
+
+      for (int n_err = 1; n_err <= t + 4; ++n_err) {
+        std::vector<uint8_t> rx = orig, rx_ecc = ecc;
+        // Distinct bits: stride 8 * len / (t + 4) apart
+        for (int e = 0; e < n_err; ++e) {
+          size_t bit = (size_t)e * (8 * len / (t + 4)) + n_err % 7;
+          rx[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+        }
+        int count = code.decode(rx.data(), len, rx_ecc.data());
+        if (n_err <= t) {
+          ASSERT_EQ(n_err, count, "BM correction count " + tag);
+          ASSERT_TRUE(rx == orig, "BM corrected data " + tag);
+        } else {
+          ASSERT_TRUE(count == -1 ||
+                          (count <= t &&
+                           code.check(rx.data(), len, rx_ecc.data())),
+                      "BM beyond t " + tag);
+        }
+      }
+    }
+  }
+  PASS("Berlekamp-Massey");
+
+  // 24. TableMode::Lazy: tables appear per stage on first use, results and
+  // blobs match the eager code, and first use from many threads is safe
+  {
+    const int N = 8191, t = 20;
+    auto eager = std::make_shared<lite::LiteBCHCode>(N, t);
+    auto lazy = std::make_shared<lite::LiteBCHCode>(
+        N, t, std::vector<int>(), lite::TableMode::Lazy);
+    lite::LiteBCHCode::MemoryUsage full = eager->memory_usage();
+    lite::LiteBCHCode::MemoryUsage none = lazy->memory_usage();
+    ASSERT_TRUE(full.encoder > 0 && full.decoder > 0, "Eager tables");
+    ASSERT_TRUE(none.gf == full.gf && none.encoder == 0 && none.decoder == 0,
+                "Lazy construction builds the field only");
+
+    const size_t len = 512;
+    std::vector<uint8_t> data(len), ecc_e(eager->get_ecc_bytes()),
+        ecc_l(ecc_e.size());
+    for (size_t i = 0; i < len; ++i)
+      data[i] = (uint8_t)(i * 31 + 7);
+    lite::LiteBCH enc(lazy);
+    lite::LiteBCH ref(eager);
+    enc.encode(data.data(), len, ecc_l.data());
+    ref.encode(data.data(), len, ecc_e.data());
+    ASSERT_TRUE(ecc_l == ecc_e, "Lazy encode");
+    ASSERT_TRUE(lazy->memory_usage().encoder > 0 &&
+                    lazy->memory_usage().decoder == 0,
+                "Encoding builds no decoder tables");
+
+    data[3] ^= 0x40;
+    ASSERT_EQ(1, enc.decode(data.data(), len, ecc_l.data()), "Lazy decode");
+    ASSERT_TRUE(lazy->memory_usage().decoder == full.decoder,
+                "Decoder tables on first decode");
+    ASSERT_TRUE(enc.memory_usage().workspace > 0 &&
+                    enc.memory_usage().total() >
+                        lazy->memory_usage().total(),
+                "LiteBCH counts its Workspace");
+
+    auto lazy_blob = std::make_shared<lite::LiteBCHCode>(
+        N, t, std::vector<int>(), lite::TableMode::Lazy);
+    ASSERT_TRUE(lazy_blob->serialize() == eager->serialize(),
+                "Lazy serialize");
+
+    // Batch encode/decode on a fresh lazy code from 4 threads at once
+    auto fresh = std::make_shared<lite::LiteBCHCode>(
+        N, t, std::vector<int>(), lite::TableMode::Lazy);
+    const size_t count = 64;
+    std::vector<uint8_t> batch(len * count), pecc(ecc_e.size() * count),
+        secc(pecc.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+      batch[i] = (uint8_t)(i * 131 + i / 509);
+    lite::ParallelBCH par(fresh, 4, 1);
+    par.encode_batch(batch.data(), len, len, count, pecc.data(),
+                     ecc_e.size());
+    ref.encode_batch(batch.data(), len, len, count, secc.data(),
+                     ecc_e.size());
+    ASSERT_TRUE(pecc == secc, "Lazy parallel encode");
+    for (size_t c = 0; c < count; ++c)
+      batch[c * len + c % len] ^= 1;
+    ASSERT_EQ(0u, par.decode_batch(batch.data(), len, len, count,
+                                   pecc.data(), ecc_e.size()),
+              "Lazy parallel decode");
+  }
+  PASS("Lazy tables");
+
+  // 25. Wide fields (m > 16): no log tables, same API and results contract
+  {
+    const int codes[][2] = {{(1 << 17) - 1, 6}, {(1 << 20) - 1, 12},
+                            {(1 << 24) - 1, 3}};
+    for (const auto &nt : codes) {
+      lite::LiteBCH code(nt[0], nt[1]);
+      const int t = nt[1];
+      const std::string tag = "N=" + std::to_string(nt[0]);
+      ASSERT_TRUE(code.get_K() > 0 && nt[0] - code.get_K() <= 24 * t,
+                  "Wide dimensions " + tag);
+      const size_t len = 2048;
+      std::vector<uint8_t> data(len), ecc(code.get_ecc_bytes());
+      for (size_t i = 0; i < len; ++i)
+        data[i] = (uint8_t)(i * 53 + (i >> 5));
+      code.encode(data.data(), len, ecc.data());
+      ASSERT_TRUE(code.check(data.data(), len, ecc.data()),
+                  "Wide codeword " + tag);
+      std::vector<int> s(2 * t + 1);
+      lite::LiteBCHCode::Workspace ws(*code.get_code());
+      ASSERT_TRUE(!code.get_code()->syndromes(data.data(), len, ecc.data(),
+                                              s.data(), ws),
+                  "Wide clean syndromes " + tag);
+
+      for (int n_err = 1; n_err <= t; ++n_err) {
+        std::vector<uint8_t> rx = data, rx_ecc = ecc;
+        for (int e = 0; e < n_err; ++e) {
+          size_t bit = (size_t)e * 977 + n_err * 13;
+          rx[bit / 8 % len] ^= (uint8_t)(1 << (bit % 8));
+        }
+        if (n_err > 1)
+          rx_ecc[0] ^= 0x80; // one error in the ECC
+        const int expect = n_err + (n_err > 1);
+        if (expect > t)
+          continue;
+        ASSERT_TRUE(code.get_code()->syndromes(rx.data(), len, rx_ecc.data(),
+                                               s.data(), ws),
+                    "Wide syndromes " + tag);
+        ASSERT_EQ(expect, code.decode(rx.data(), len, rx_ecc.data()),
+                  "Wide decode count " + tag);
+        ASSERT_TRUE(rx == data && rx_ecc == ecc, "Wide corrected " + tag);
+      }
+
+      std::vector<uint8_t> blob = code.get_code()->serialize();
+      lite::LiteBCH loaded(
+          lite::LiteBCHCode::deserialize(blob.data(), blob.size()));
+      std::vector<uint8_t> rx = data, rx_ecc = ecc;
+      rx[len / 2] ^= 0x21;
+      ASSERT_EQ(2, loaded.decode(rx.data(), len, rx_ecc.data()),
+                "Wide decode after deserialize " + tag);
+      ASSERT_TRUE(rx == data, "Wide deserialized correction " + tag);
+    }
+
+    // Bit-per-element API on a wide code
+    lite::LiteBCH vec((1 << 17) - 1, 4);
+    std::vector<int> msg(vec.get_K());
+    for (size_t i = 0; i < msg.size(); ++i)
+      msg[i] = (i * 7 + i / 3) % 5 == 0;
+    std::vector<int> cw = vec.encode(msg), dec;
+    cw[3] ^= 1;
+    cw[90000] ^= 1;
+    ASSERT_TRUE(vec.decode(cw, dec) && dec == msg, "Wide vector decode");
+    bool threw = false;
+    vec.set_reference_mode(lite::ReferenceMode::BitSerial);
+    try {
+      vec.decode(cw, dec);
+    } catch (const std::invalid_argument &) {
+      threw = true;
+    }
+    ASSERT_TRUE(threw, "No bit-serial decoder for wide fields");
+  }
+  PASS("Wide fields");
+
+  // 26. Chase-II: t + 2 errors on unreliable bits are corrected from LLRs
+  {
+    const int codes[][2] = {{1023, 8}, {(1 << 17) - 1, 3}};
+    for (const auto &nt : codes) {
+      lite::LiteBCH code(nt[0], nt[1]);
+      const int N = code.get_N(), K = code.get_K(), t = code.get_t();
+      const int r = N - K;
+      const std::string tag = "N=" + std::to_string(N);
+      const size_t len = (K + 7) / 8;
+      std::vector<uint8_t> data(len), ecc(code.get_ecc_bytes());
+      for (size_t i = 0; i < len; ++i)
+        data[i] = (uint8_t)(i * 29 + 3);
+      code.encode(data.data(), len, ecc.data());
+
+      // Coefficient j of the codeword, in the layout of decode_chase's llr
+      auto flip = [&](uint8_t *d, uint8_t *e, int j) {
+        if (j < r) {
+          e[j / 8] ^= (uint8_t)(1 << (j % 8));
+        } else {
+          int pos = K - 1 - (j - r);
+          d[pos / 8] ^= (uint8_t)(0x80 >> (pos % 8));
+        }
+      };
+      std::vector<float> llr(N);
+      for (int j = 0; j < N; ++j)
+        llr[j] = 4.0f + (float)(j % 7); // sign is not used by decode_chase
+      const int n_err = t + 2;
+      std::vector<int> err_at;
+      for (int e = 0; e < n_err; ++e)
+        err_at.push_back((e * 7919 + 5) % N);
+      std::vector<uint8_t> rx = data, rx_ecc = ecc;
+      for (int k = 0; k < n_err; ++k) {
+        flip(rx.data(), rx_ecc.data(), err_at[k]);
+        if (k < 3) // three of them among the unreliable bits
+          llr[err_at[k]] = 0.5f + 0.1f * (float)k;
+      }
+      ASSERT_EQ(-1, code.decode(rx.data(), len, rx_ecc.data()),
+                "Past t for the hard decoder " + tag);
+      rx = data, rx_ecc = ecc;
+      for (int j : err_at)
+        flip(rx.data(), rx_ecc.data(), j);
+      ASSERT_EQ(n_err, code.decode_chase(rx.data(), len, rx_ecc.data(),
+                                         llr.data(), 4),
+                "Chase changed bits " + tag);
+      ASSERT_TRUE(rx == data && rx_ecc == ecc, "Chase corrected " + tag);
+      ASSERT_EQ(0, code.decode_chase(rx.data(), len, rx_ecc.data(), llr.data(),
+                                     4),
+                "Chase on a codeword " + tag);
+
+      // p = 0 is the hard decoder
+      rx[1] ^= 0x44;
+      ASSERT_EQ(2, code.decode_chase(rx.data(), len, rx_ecc.data(), llr.data(),
+                                     0),
+                "Chase without test patterns " + tag);
+      ASSERT_TRUE(rx == data, "Chase p = 0 corrected " + tag);
+      bool threw = false;
+      try {
+        code.decode_chase(rx.data(), len, rx_ecc.data(), llr.data(), 17);
+      } catch (const std::invalid_argument &) {
+        threw = true;
+      }
+      ASSERT_TRUE(threw, "Chase rejects p > 16 " + tag);
+    }
+
+    // Bit API and aff3ct decode_siho on BPSK LLRs (negative = 1)
+    const int N = 255, t = 4;
+    lite::LiteBCH code(N, t);
+    const int K = code.get_K();
+    std::vector<int> msg(K);
+    for (int i = 0; i < K; ++i)
+      msg[i] = (i * 5 + i / 7) % 3 == 0;
+    std::vector<int> cw = code.encode(msg);
+    std::vector<float> llr(N);
+    for (int j = 0; j < N; ++j)
+      llr[j] = (cw[j] ? -1.0f : 1.0f) * (3.0f + (float)(j % 5));
+    const int weak[] = {3, 40, 100, 180, 250, 7}; // t + 2 sign errors
+    for (int k = 0; k < t + 2; ++k)
+      llr[weak[k]] = (cw[weak[k]] ? 1.0f : -1.0f) * (k < 3 ? 0.25f : 2.0f);
+    std::vector<int> out(K);
+    ASSERT_EQ(t + 2, code.decode_chase_bits(llr.data(), out.data(), 3),
+              "Chase bits changed");
+    ASSERT_TRUE(out == msg, "Chase bits message");
+
+    aff3ct::tools::BCH_polynomial_generator<int> gen(N, t);
+    aff3ct::module::Decoder_BCH_std<int, double> dec(K, N, gen);
+    std::vector<double> y(llr.begin(), llr.end());
+    std::vector<int> v, v_hard;
+    std::vector<int> hard(N);
+    for (int j = 0; j < N; ++j)
+      hard[j] = y[j] < 0;
+    ASSERT_EQ(1, dec.decode_hiho(hard, v_hard), "aff3ct hiho past t");
+    dec.set_n_least_reliable_positions(3);
+    ASSERT_EQ(0, dec.decode_siho(y, v), "aff3ct siho status");
+    ASSERT_TRUE(v == msg, "aff3ct siho message");
+  }
+  PASS("Chase-II soft decoding");
+
+  // 27. Decode pipeline: same results as decode(), and back-pressure
+  {
+    auto shared = lite::LiteBCHCode::get(8191, 12);
+    const int t = shared->get_t();
+    const size_t len = 512, count = 300;
+    const size_t ecc_bytes = shared->get_ecc_bytes();
+    std::vector<uint8_t> data(len * count), ecc(ecc_bytes * count);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = (uint8_t)(i * 37 + (i >> 9));
+    lite::LiteBCH ref(shared);
+    for (size_t c = 0; c < count; ++c)
+      ref.encode(&data[c * len], len, &ecc[c * ecc_bytes]);
+    std::vector<uint8_t> rx = data, rx_ecc = ecc;
+    std::vector<int> expect(count);
+    for (size_t c = 0; c < count; ++c) {
+      const int n_err = (int)(c % (t + 3)); // clean, correctable, beyond t
+      for (int e = 0; e < n_err; ++e)
+        rx[c * len + (e * 41 + c) % len] ^= (uint8_t)(1 << (e % 8));
+      std::vector<uint8_t> d(rx.begin() + c * len, rx.begin() + (c + 1) * len);
+      std::vector<uint8_t> p(rx_ecc.begin() + c * ecc_bytes,
+                             rx_ecc.begin() + (c + 1) * ecc_bytes);
+      expect[c] = ref.decode(d.data(), len, p.data());
+    }
+
+    std::vector<int> got(count, -2);
+    {
+      lite::DecodePipeline pipe(shared, 3, 16);
+      for (size_t c = 0; c < count; ++c) {
+        int *slot = &got[c];
+        while (!pipe.try_submit(&rx[c * len], len, &rx_ecc[c * ecc_bytes],
+                                [slot](int r) { *slot = r; }))
+          std::this_thread::yield(); // Full: the I/O thread would reap here
+      }
+      pipe.drain();
+      ASSERT_EQ(0u, pipe.in_flight(), "Pipeline drained");
+    }
+    ASSERT_TRUE(got == expect, "Pipeline results match decode()");
+    for (size_t c = 0; c < count; ++c)
+      if (expect[c] >= 0) {
+        ASSERT_TRUE(std::equal(&rx[c * len], &rx[c * len] + len,
+                               &data[c * len]),
+                    "Pipeline corrected codeword " + std::to_string(c));
+      }
+
+    // One worker held in a completion; the queue then takes exactly its
+    // capacity and refuses the next word without blocking.
+    lite::DecodePipeline pipe(shared, 1, 2);
+    std::atomic<bool> started(false), release(false);
+    ASSERT_TRUE(pipe.try_submit(&data[0], len, &ecc[0],
+                                [&](int) {
+                                  started = true;
+                                  while (!release)
+                                    std::this_thread::yield();
+                                }),
+                "Pipeline first submit");
+    while (!started)
+      std::this_thread::yield();
+    ASSERT_TRUE(pipe.try_submit(&data[len], len, &ecc[ecc_bytes], nullptr),
+                "Pipeline second submit");
+    std::future<int> f =
+        pipe.try_submit(&data[2 * len], len, &ecc[2 * ecc_bytes]);
+    ASSERT_TRUE(f.valid(), "Pipeline future submit");
+    std::future<int> full =
+        pipe.try_submit(&data[3 * len], len, &ecc[3 * ecc_bytes]);
+    ASSERT_TRUE(!full.valid(), "Pipeline refuses a word when full");
+    ASSERT_EQ(3u, pipe.in_flight(), "Pipeline in flight");
+    release = true;
+    ASSERT_EQ(0, f.get(), "Pipeline future result");
+    pipe.drain();
+    bool threw = false;
+    try {
+      pipe.try_submit(&data[0], len * count, &ecc[0], nullptr);
+    } catch (const std::invalid_argument &) {
+      threw = true;
+    }
+    ASSERT_TRUE(threw, "Pipeline checks len");
+  }
+  PASS("Decode pipeline");
+
+  // 28. Decoder statistics and trace hook (counted in LITEBCH_STATS builds)
+  {
+    struct Trace {
+      int calls = 0;
+      int last = -2;
+      uint64_t cycles = 0;
+    } trace;
+    auto hook = [](void *user, const lite::LiteBCHCode::TraceEvent &ev) {
+      Trace *tr = static_cast<Trace *>(user);
+      tr->calls++;
+      tr->last = ev.result;
+      for (int i = 0; i < lite::LiteBCHCode::DecodeStats::n_stages; ++i)
+        tr->cycles += ev.cycles[i];
+    };
+    auto shared = lite::LiteBCHCode::get(8191, 8);
+    lite::LiteBCH code(shared);
+    code.set_trace_hook(hook, &trace);
+    const int t = code.get_t();
+    const size_t len = 256, count = 40;
+    const size_t ecc_bytes = code.get_ecc_bytes();
+    std::vector<uint8_t> data(len * count), ecc(ecc_bytes * count);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = (uint8_t)(i * 11 + 1);
+    for (size_t c = 0; c < count; ++c)
+      code.encode(&data[c * len], len, &ecc[c * ecc_bytes]);
+    for (size_t c = 0; c < count; ++c)
+      for (size_t e = 0; e < c % (t + 4); ++e) // up to t + 3 errors
+        data[c * len + e * 13] ^= 0x08;
+
+    std::vector<uint8_t> rx = data, rx_ecc = ecc;
+    std::vector<int> errors(count);
+    uint64_t clean = 0, corrected = 0, failed = 0, three = 0;
+    code.decode_batch(rx.data(), len, len, count, rx_ecc.data(), ecc_bytes,
+                      errors.data());
+    for (int r : errors) {
+      clean += r == 0;
+      corrected += r > 0;
+      failed += r < 0;
+      three += r == 3;
+    }
+    const lite::LiteBCHCode::DecodeStats &st = code.stats();
+    if (lite::LiteBCHCode::stats_enabled()) {
+      ASSERT_EQ((uint64_t)count, st.decoded, "Stats decoded");
+      ASSERT_EQ(clean, st.clean, "Stats clean");
+      ASSERT_EQ(corrected, st.corrected, "Stats corrected");
+      ASSERT_EQ(failed, st.failed, "Stats failed");
+      ASSERT_EQ((size_t)t + 1, st.errors.size(), "Stats histogram bins");
+      ASSERT_EQ(clean, st.errors[0], "Stats histogram clean");
+      ASSERT_EQ(three, st.errors[3], "Stats histogram 3 errors");
+      ASSERT_TRUE(st.cycles[lite::LiteBCHCode::DecodeStats::Syndromes] > 0,
+                  "Stats syndrome cycles");
+      ASSERT_EQ((int)count, trace.calls, "Trace calls");
+      ASSERT_EQ(errors.back(), trace.last, "Trace last result");
+    } else {
+      ASSERT_EQ(0u, st.decoded, "Stats off: nothing counted");
+      ASSERT_EQ(0, trace.calls, "Stats off: no trace calls");
+    }
+    code.reset_stats();
+    ASSERT_EQ(0u, code.stats().decoded, "Stats reset");
+    ASSERT_EQ((size_t)t + 1, code.stats().errors.size(), "Stats reset bins");
+
+    // Chase-II decodes count one word each, like decode()
+    std::vector<float> llr(code.get_N(), 4.0f);
+    for (int j = 0; j < 4; ++j)
+      llr[j] = 0.5f; // the test positions
+    rx = data, rx_ecc = ecc;
+    trace.calls = 0;
+    ASSERT_EQ(5, code.decode_chase(&rx[5 * len], len, &rx_ecc[5 * ecc_bytes],
+                                   llr.data(), 4),
+              "Chase decode for stats");
+    ASSERT_EQ(0, code.decode_chase(&rx[0], len, &rx_ecc[0], llr.data(), 4),
+              "Chase clean decode for stats");
+    const lite::LiteBCHCode::DecodeStats &cs = code.stats();
+    if (lite::LiteBCHCode::stats_enabled()) {
+      using Stage = lite::LiteBCHCode::DecodeStats;
+      ASSERT_EQ(2u, cs.decoded, "Chase stats decoded");
+      ASSERT_EQ(1u, cs.clean, "Chase stats clean");
+      ASSERT_EQ(1u, cs.corrected, "Chase stats corrected");
+      ASSERT_EQ(1u, cs.errors[5], "Chase stats histogram");
+      ASSERT_TRUE(cs.cycles[Stage::Locator] > 0 && cs.cycles[Stage::Roots] > 0,
+                  "Chase stats locator and root cycles");
+      ASSERT_EQ(2, trace.calls, "Chase trace calls");
+      ASSERT_EQ(0, trace.last, "Chase trace last result");
+    } else {
+      ASSERT_EQ(0u, cs.decoded, "Stats off: Chase not counted");
+      ASSERT_EQ(0, trace.calls, "Stats off: no Chase trace calls");
+    }
+
+    // Per-worker counters, merged
+    lite::ParallelBCH par(shared, 3, 4);
+    rx = data, rx_ecc = ecc;
+    par.decode_batch(rx.data(), len, len, count, rx_ecc.data(), ecc_bytes);
+    lite::LiteBCHCode::DecodeStats ps = par.stats();
+    lite::DecodePipeline pipe(shared, 2, 8);
+    rx = data, rx_ecc = ecc;
+    for (size_t c = 0; c < count; ++c)
+      while (!pipe.try_submit(&rx[c * len], len, &rx_ecc[c * ecc_bytes],
+                              nullptr))
+        std::this_thread::yield();
+    pipe.drain();
+    lite::LiteBCHCode::DecodeStats qs = pipe.stats();
+    const uint64_t expect = lite::LiteBCHCode::stats_enabled() ? count : 0;
+    ASSERT_EQ(expect, ps.decoded, "Parallel stats decoded");
+    ASSERT_EQ(expect ? failed : 0, ps.failed, "Parallel stats failed");
+    ASSERT_EQ(expect, qs.decoded, "Pipeline stats decoded");
+    ASSERT_EQ(expect ? corrected : 0, qs.corrected, "Pipeline stats corrected");
+  }
+  PASS("Decoder statistics");
+
+  // 29. Erasures and position hints
+  {
+    const int codes[][2] = {{4095, 10}, {(1 << 17) - 1, 4}};
+    for (const auto &nt : codes) {
+      lite::LiteBCH code(nt[0], nt[1]);
+      const int K = code.get_K(), t = code.get_t(), r = code.get_N() - K;
+      const std::string tag = "N=" + std::to_string(nt[0]);
+      const size_t len = 300;
+      std::vector<uint8_t> data(len), ecc(code.get_ecc_bytes());
+      for (size_t i = 0; i < len; ++i)
+        data[i] = (uint8_t)(i * 101 + 7);
+      code.encode(data.data(), len, ecc.data());
+      const int bits = 8 * (int)len; // message bits of the shortened word
+      auto flip = [&](uint8_t *d, uint8_t *e, int j) {
+        if (j < r) {
+          e[j / 8] ^= (uint8_t)(1 << (j % 8));
+        } else {
+          int pos = bits - 1 - (j - r);
+          d[pos / 8] ^= (uint8_t)(0x80 >> (pos % 8));
+        }
+      };
+
+      // v errors plus e erasures (most of them wrong) with 2v + e = 2t,
+      // beyond what decode() corrects
+      const int v = t / 2, e = 2 * t - 2 * v;
+      std::vector<int> erased;
+      std::vector<uint8_t> rx = data, rx_ecc = ecc;
+      for (int k = 0; k < v; ++k)
+        flip(rx.data(), rx_ecc.data(), r + 97 * k + 3);
+      for (int k = 0; k < e; ++k) {
+        erased.push_back(r + 97 * k + 50);
+        if (k % 5)
+          flip(rx.data(), rx_ecc.data(), erased.back());
+      }
+      erased.push_back(erased.front()); // duplicates are ignored
+      std::vector<uint8_t> plain = rx, plain_ecc = rx_ecc;
+      code.reset_stats();
+      ASSERT_EQ(-1, code.decode(plain.data(), len, plain_ecc.data()),
+                "Erasures beyond decode() " + tag);
+      const int wrong = v + e - (e + 4) / 5;
+      ASSERT_EQ(wrong, code.decode_erasures(rx.data(), len, rx_ecc.data(),
+                                            erased.data(), erased.size()),
+                "Erasure decode changed bits " + tag);
+      ASSERT_TRUE(rx == data && rx_ecc == ecc, "Erasure decode " + tag);
+      if (lite::LiteBCHCode::stats_enabled()) {
+        const lite::LiteBCHCode::DecodeStats &st = code.stats();
+        ASSERT_EQ(2u, st.decoded, "Erasure stats decoded " + tag);
+        ASSERT_EQ(1u, st.failed, "Erasure stats failed " + tag);
+        ASSERT_EQ(1u, st.corrected, "Erasure stats corrected " + tag);
+        ASSERT_TRUE(st.cycles[lite::LiteBCHCode::DecodeStats::Roots] > 0,
+                    "Erasure stats root cycles " + tag);
+      }
+
+      // Hints: same result as decode(), whether they are all, some or none
+      // of the errors, and with false hints mixed in
+      std::vector<int> err_at;
+      for (int k = 0; k < t; ++k)
+        err_at.push_back(k % 3 ? r + 211 * k + 1 : 13 * k);
+      for (int n_hint : {t, t - 2, 0}) {
+        rx = data, rx_ecc = ecc;
+        for (int j : err_at)
+          flip(rx.data(), rx_ecc.data(), j);
+        std::vector<int> hints(err_at.begin(), err_at.begin() + n_hint);
+        hints.push_back(r + 5);
+        hints.push_back(1);
+        ASSERT_EQ(t, code.decode_hinted(rx.data(), len, rx_ecc.data(),
+                                        hints.data(), hints.size()),
+                  "Hinted decode count " + tag);
+        ASSERT_TRUE(rx == data && rx_ecc == ecc, "Hinted decode " + tag);
+      }
+      rx[0] ^= 0x01;
+      rx[1] ^= 0x80;
+      rx[2] ^= 0x10;
+      ASSERT_EQ(3, code.decode_hinted(rx.data(), len, rx_ecc.data(), nullptr,
+                                      0),
+                "Hinted decode without hints " + tag);
+      ASSERT_TRUE(rx == data, "Hinted decode without hints content " + tag);
+
+      bool threw = false;
+      const int outside = r + bits;
+      try {
+        code.decode_erasures(rx.data(), len, rx_ecc.data(), &outside, 1);
+      } catch (const std::invalid_argument &) {
+        threw = true;
+      }
+      ASSERT_TRUE(threw, "Erasure outside the codeword " + tag);
+    }
+  }
+  PASS("Erasures and position hints");
+
+  // 30. Parity update: same ECC as re-encoding, for fields anywhere in full
+  // length (partial last byte) and shortened messages, on every encoder
+  {
+    const int codes[][2] = {{8191, 8}, {1023, 4}, {(1 << 17) - 1, 4}};
+    for (const auto &enc : lite::encode_backends()) {
+      lite::set_encode_backend(enc);
+      for (const auto &nt : codes) {
+        lite::LiteBCH code(nt[0], nt[1]);
+        const std::string tag = enc + " N=" + std::to_string(nt[0]);
+        const size_t full = (code.get_K() + 7) / 8;
+        const size_t lens[] = {full, full / 3 + 1,
+                               std::min<size_t>(full, 9000)};
+        for (size_t len : lens) {
+          std::vector<uint8_t> data(len), ecc(code.get_ecc_bytes());
+          for (size_t i = 0; i < len; ++i)
+            data[i] = (uint8_t)(i * 37 + 11);
+          code.encode(data.data(), len, ecc.data());
+          const size_t fields[][2] = {{0, 1},      {0, len},     {len - 1, 1},
+                                      {len - 5, 5}, {len / 2, 3}, {7, 300},
+                                      {1, 0}};
+          for (const auto &f : fields) {
+            const size_t off = std::min(f[0], len - 1);
+            const size_t n = std::min(f[1], len - off);
+            std::vector<uint8_t> old(data.begin() + off,
+                                     data.begin() + off + n);
+            for (size_t i = 0; i < n; ++i)
+              data[off + i] ^= (uint8_t)(i * 53 + 1);
+            code.update_ecc(ecc.data(), len, off, old.data(), &data[off], n);
+            std::vector<uint8_t> ref(code.get_ecc_bytes());
+            code.encode(data.data(), len, ref.data());
+            ASSERT_TRUE(ecc == ref, "Parity update " + tag + " len=" +
+                                        std::to_string(len) + " offset=" +
+                                        std::to_string(off));
+          }
+        }
+
+        bool threw = false;
+        std::vector<uint8_t> data(16), ecc(code.get_ecc_bytes());
+        try {
+          code.update_ecc(ecc.data(), 16, 10, data.data(), data.data(), 7);
+        } catch (const std::invalid_argument &) {
+          threw = true;
+        }
+        ASSERT_TRUE(threw, "Parity update past the message " + tag);
+      }
+    }
+    lite::set_encode_backend("auto");
+  }
+  PASS("Parity update");
+
   std::cout << "ALL TESTS PASSED." << std::endl;
   return 0;
 }
@@ -0,0 +1,133 @@
+const fs = require('fs');
+const path = require('path');
+
+// Locate the build-wasm directory
+const wasmPath = path.resolve(__dirname, '../build-wasm/litebch.js');
+
+if (!fs.existsSync(wasmPath)) {
+    console.error(`Error: Could not find WASM build at ${wasmPath}`);
+    process.exit(1);
+}
+
+const createLiteBCH = require(wasmPath);
+
+// --- LCG Logic (Must match repro_common.h) ---
+class SimpleLCG {
+    constructor(seed) {
+        this.state = seed >>> 0;
+    }
+    next() {
+        const a = 1103515245n;
+        const c = 12345n;
+        const m = 0x7FFFFFFFn;
+        let s = BigInt(this.state);
+        s = (a * s + c) & m;
+        this.state = Number(s);
+        return this.state;
+    }
+}
+
+function fail(msg) {
+    console.error(`FAIL: ${msg}`);
+    process.exit(1);
+}
+
+createLiteBCH().then(Module => {
+    console.log("LiteBCH WASM Module Loaded for Raw Pointer Test.");
+    console.log(`Vector backend: ${Module.vector_backend()}`);
+
+    const bch = new Module.LiteBCH(8191, 8); // m = 13
+    const eccBytes = bch.ecc_bytes;
+    const len = 512;
+    const count = 64;
+    const lcg = new SimpleLCG(42);
+
+    // All buffers live in the wasm heap: no copies per call.
+    const dataPtr = Module._malloc(len * count);
+    const eccPtr = Module._malloc(eccBytes * count);
+    const refPtr = Module._malloc(len * count);
+    const heap = () => Module.HEAPU8; // re-read: memory may grow
+
+    for (let i = 0; i < len * count; ++i) {
+        heap()[dataPtr + i] = lcg.next() & 0xFF;
+    }
+    heap().copyWithin(refPtr, dataPtr, dataPtr + len * count);
+
+    // 1. Batch encode matches single encode
+    bch.encode_batch_raw_ptr(dataPtr, len, len, count, eccPtr, eccBytes);
+    const single = Module._malloc(eccBytes);
+    for (let c = 0; c < count; ++c) {
+        bch.encode_raw_ptr(dataPtr + c * len, len, single);
+        for (let j = 0; j < eccBytes; ++j) {
+            if (heap()[single + j] !== heap()[eccPtr + c * eccBytes + j]) {
+                fail(`batch ECC differs from encode_raw_ptr (codeword ${c})`);
+            }
+        }
+    }
+    Module._free(single);
+    if (!bch.check_raw_ptr(dataPtr, len, eccPtr)) fail("check_raw_ptr");
+
+    // 2. decode_raw_ptr corrects in place
+    heap()[dataPtr + 7] ^= 0x10;
+    heap()[dataPtr + 300] ^= 0x01;
+    if (bch.check_raw_ptr(dataPtr, len, eccPtr)) fail("check_raw_ptr on errors");
+    if (bch.decode_raw_ptr(dataPtr, len, eccPtr) !== 2) fail("decode_raw_ptr count");
+
+    // 3. Batch decode: codeword c gets c % 10 errors (> t fails with -1)
+    const flips = [];
+    for (let c = 0; c < count; ++c) {
+        const e = c % 10;
+        flips.push(e);
+        const used = new Set();
+        while (used.size < e) {
+            used.add(lcg.next() % (len * 8));
+        }
+        for (const bit of used) {
+            heap()[dataPtr + c * len + (bit >> 3)] ^= 1 << (bit & 7);
+        }
+    }
+    const errors = bch.decode_batch_raw_ptr(dataPtr, len, len, count, eccPtr, eccBytes);
+    if (!(errors instanceof Int32Array) || errors.length !== count) {
+        fail("decode_batch_raw_ptr must return an Int32Array of count entries");
+    }
+    for (let c = 0; c < count; ++c) {
+        const ok = flips[c] <= 8;
+        if (ok && errors[c] !== flips[c]) fail(`errors[${c}] = ${errors[c]}, expected ${flips[c]}`);
+        if (!ok && errors[c] !== -1) fail(`errors[${c}] = ${errors[c]}, expected -1`);
+        if (!ok) continue;
+        for (let i = 0; i < len; ++i) {
+            if (heap()[dataPtr + c * len + i] !== heap()[refPtr + c * len + i]) {
+                fail(`codeword ${c} not corrected`);
+            }
+        }
+    }
+
+    // 4. ParallelBCH gives the same results (one thread without -pthread)
+    const par = new Module.ParallelBCH(bch, 0);
+    console.log(`ParallelBCH threads: ${par.get_threads()}`);
+    heap().copyWithin(dataPtr, refPtr, refPtr + len * count);
+    par.encode_batch_raw_ptr(dataPtr, len, len, count, eccPtr, eccBytes);
+    heap()[dataPtr + 5 * len] ^= 0x80;
+    const perrors = par.decode_batch_raw_ptr(dataPtr, len, len, count, eccPtr, eccBytes);
+    for (let c = 0; c < count; ++c) {
+        if (perrors[c] !== (c === 5 ? 1 : 0)) fail(`parallel errors[${c}] = ${perrors[c]}`);
+    }
+    par.delete();
+
+    // 5. Uint8Array convenience API
+    const msg = heap().slice(refPtr, refPtr + len);
+    const ecc = bch.encode_bytes(msg);
+    msg[42] ^= 0x04;
+    if (bch.decode_bytes(msg, ecc) !== 1 || msg[42] !== heap()[refPtr + 42]) {
+        fail("decode_bytes");
+    }
+
+    Module._free(dataPtr);
+    Module._free(eccPtr);
+    Module._free(refPtr);
+    bch.delete();
+    console.log("PASS: raw pointer and batch bindings");
+}).catch(e => {
+    console.error(e);
+    process.exit(1);
+});
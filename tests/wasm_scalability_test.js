@@ -0,0 +1,333 @@
+const fs = require('fs');
+const path = require('path');
+
+// WASM port of scalability_test.cpp: the same m / t sweep over full-length
+// codewords, the same CSV columns and the same checks (log-log slopes of
+// the costs, and memory / timings against a baseline).
+//
+//   node tests/wasm_scalability_test.js [--quick] [--baseline FILE]
+//        [--tolerance X] [--slope X] [--save FILE] [--csv] [--module FILE]
+//
+// The memory columns match the native baseline (tests/baselines/
+// scalability.csv); timings need a baseline saved from the WASM build.
+
+const args = process.argv.slice(2);
+const opt = {
+    m: [5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16],
+    t: [1, 2, 4, 8, 16, 32, 64],
+    passes: 5,
+    bits: 1 << 22,
+    slope: 1.5,
+    tolerance: 2.0,
+    memSlack: 0.02,
+    baseline: null,
+    save: null,
+    csv: false,
+    module: path.resolve(__dirname, '../build_wasm/litebch.js'),
+};
+for (let i = 0; i < args.length; ++i) {
+    const a = args[i];
+    const value = () => {
+        if (i + 1 >= args.length) {
+            console.error(`Missing value for ${a}`);
+            process.exit(1);
+        }
+        return args[++i];
+    };
+    if (a === '--quick') {
+        opt.m = [5, 8, 11, 13];
+        opt.t = [1, 2, 4, 8, 16];
+        opt.passes = 3;
+        opt.bits = 1 << 20;
+    } else if (a === '--baseline') opt.baseline = value();
+    else if (a === '--tolerance') opt.tolerance = parseFloat(value());
+    else if (a === '--slope') opt.slope = parseFloat(value());
+    else if (a === '--save') opt.save = value();
+    else if (a === '--csv') opt.csv = true;
+    else if (a === '--module') opt.module = path.resolve(value());
+    else {
+        console.error(`Unknown option ${a}`);
+        process.exit(1);
+    }
+}
+
+if (!fs.existsSync(opt.module)) {
+    console.error(`Error: Could not find WASM build at ${opt.module}`);
+    process.exit(1);
+}
+const createLiteBCH = require(opt.module);
+
+const FIELDS = ['m', 'N', 't', 'K', 'build_us', 'table_bytes', 'workspace_bytes',
+                'encode_mbps', 'decode_clean_ns', 'decode_half_ns', 'decode_t_ns'];
+
+// Same thresholds as scalability_test.cpp
+const MIN_NS = 2000;
+const CLOSED_FORM = 4;
+const COSTS = [
+    { name: 'build_us', get: r => r.build_us, ns: 1e3, roots: false },
+    { name: 'table_bytes', get: r => r.table_bytes, ns: 0, roots: false },
+    { name: 'encode_ns', get: r => r.K / r.encode_mbps * 1e3, ns: 1, roots: false },
+    { name: 'decode_clean_ns', get: r => r.decode_clean_ns, ns: 1, roots: false },
+    { name: 'decode_t_ns', get: r => r.decode_t_ns, ns: 1, roots: true },
+];
+
+// --- LCG Logic (Must match repro_common.h) ---
+class SimpleLCG {
+    constructor(seed) {
+        this.state = seed >>> 0;
+    }
+    next() {
+        const a = 1103515245n;
+        const c = 12345n;
+        const m = 0x7FFFFFFFn;
+        let s = BigInt(this.state);
+        s = (a * s + c) & m;
+        this.state = Number(s);
+        return this.state;
+    }
+}
+
+function run(Module, m, t, lcg) {
+    const N = (1 << m) - 1;
+    const r = { m, N, t, failures: 0 };
+
+    r.build_us = Infinity;
+    for (let p = 0; p < opt.passes; ++p) {
+        const start = performance.now();
+        const fresh = new Module.LiteBCH(N, t);
+        r.build_us = Math.min(r.build_us, (performance.now() - start) * 1e3);
+        fresh.delete();
+    }
+
+    const bch = new Module.LiteBCH(N, t);
+    r.K = bch.get_K();
+    r.table_bytes = bch.table_bytes();
+    const len = (r.K + 7) >> 3;
+    const eb = bch.ecc_bytes;
+    const n = Math.max(8, Math.floor(opt.bits / N));
+
+    const data = Module._malloc(len * n);
+    const ecc = Module._malloc(eb * n);
+    const work = Module._malloc(len * n);
+    const workEcc = Module._malloc(eb * n);
+    const heap = () => Module.HEAPU8; // re-read: memory may grow
+    for (let i = 0; i < len * n; ++i) heap()[data + i] = lcg.next() & 0xFF;
+
+    let best = Infinity;
+    for (let p = 0; p < opt.passes; ++p) {
+        const start = performance.now();
+        for (let c = 0; c < n; ++c) bch.encode_raw_ptr(data + c * len, len, ecc + c * eb);
+        best = Math.min(best, performance.now() - start);
+    }
+    r.encode_mbps = r.K * n / (best * 1e6) * 1e3;
+
+    const ref = heap().slice(data, data + len * n);
+    const refEcc = heap().slice(ecc, ecc + eb * n);
+    const counts = [0, t >> 1, t];
+    const keys = ['decode_clean_ns', 'decode_half_ns', 'decode_t_ns'];
+    for (let k = 0; k < 3; ++k) {
+        // Received words: data bits MSB-first, ECC bits LSB-first
+        const rx = ref.slice();
+        const rxEcc = refEcc.slice();
+        for (let c = 0; c < n; ++c) {
+            const used = new Set();
+            while (used.size < counts[k]) used.add(lcg.next() % N);
+            for (const p of used) {
+                if (p < r.K) rx[c * len + (p >> 3)] ^= 0x80 >> (p & 7);
+                else rxEcc[c * eb + ((p - r.K) >> 3)] ^= 1 << ((p - r.K) & 7);
+            }
+        }
+        best = Infinity;
+        for (let p = 0; p < opt.passes; ++p) {
+            heap().set(rx, work);
+            heap().set(rxEcc, workEcc);
+            let bad = 0;
+            const start = performance.now();
+            for (let c = 0; c < n; ++c) {
+                bad += bch.decode_raw_ptr(work + c * len, len, workEcc + c * eb) !== counts[k];
+            }
+            best = Math.min(best, performance.now() - start);
+            if (p === 0) {
+                const out = heap();
+                for (let i = 0; i < len * n && !bad; ++i) bad += out[work + i] !== ref[i];
+                r.failures += bad;
+            }
+        }
+        r[keys[k]] = best * 1e6 / n;
+    }
+    r.workspace_bytes = bch.workspace_bytes();
+
+    Module._free(data);
+    Module._free(ecc);
+    Module._free(work);
+    Module._free(workEcc);
+    bch.delete();
+    return r;
+}
+
+function keepBest(r, again) {
+    r.build_us = Math.min(r.build_us, again.build_us);
+    r.encode_mbps = Math.max(r.encode_mbps, again.encode_mbps);
+    for (const k of ['decode_clean_ns', 'decode_half_ns', 'decode_t_ns']) {
+        r[k] = Math.min(r[k], again[k]);
+    }
+    r.failures += again.failures;
+}
+
+function config(r) {
+    return `m=${r.m} t=${r.t}`;
+}
+
+// Least-squares slope of log y over log x
+function fitSlope(pts) {
+    let sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (const [px, py] of pts) {
+        const x = Math.log(px), y = Math.log(py);
+        sx += x; sy += y; sxx += x * x; sxy += x * y;
+    }
+    const n = pts.length;
+    return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+}
+
+function checkSweep(sweep, alongT, flags) {
+    for (const c of COSTS) {
+        const pts = [];
+        let first = null, last = null;
+        for (const r of sweep) {
+            const y = c.get(r);
+            if (!(y > 0) || (c.ns && y * c.ns < MIN_NS) || (c.roots && r.t <= CLOSED_FORM)) continue;
+            pts.push([alongT ? r.t : r.N, y]);
+            first = first || r;
+            last = r;
+        }
+        if (pts.length < 3) continue;
+        const slope = fitSlope(pts);
+        if (slope > opt.slope) {
+            flags.push(`${c.name} grows as ${alongT ? 't' : 'N'}^${slope.toFixed(2)} ` +
+                       `from ${config(first)} to ${config(last)}`);
+        }
+    }
+}
+
+function checkScaling(results, flags) {
+    const byM = new Map(), byT = new Map();
+    for (const r of results) {
+        if (!byM.has(r.m)) byM.set(r.m, []);
+        if (!byT.has(r.t)) byT.set(r.t, []);
+        byM.get(r.m).push(r);
+        byT.get(r.t).push(r);
+    }
+    for (const [m, sweep] of byM) {
+        sweep.sort((a, b) => a.t - b.t);
+        checkSweep(sweep, true, flags);
+        let sum = 0, n = 0;
+        for (const r of sweep) {
+            if ((r.t >> 1) <= CLOSED_FORM || r.decode_t_ns < MIN_NS) continue;
+            sum += Math.log(r.decode_t_ns / r.decode_half_ns) / Math.log(r.t / (r.t >> 1));
+            n++;
+        }
+        if (n >= 2 && sum / n > opt.slope) {
+            flags.push(`decode_t_ns grows as errors^${(sum / n).toFixed(2)} at m=${m}`);
+        }
+    }
+    for (const sweep of byT.values()) {
+        sweep.sort((a, b) => a.m - b.m);
+        checkSweep(sweep, false, flags);
+    }
+}
+
+function loadBaseline(file) {
+    const lines = fs.readFileSync(file, 'utf8').split('\n').slice(1);
+    const base = [];
+    for (const line of lines) {
+        if (!line || line[0] === '#') continue;
+        const v = line.split(',').map(Number);
+        if (v.length < FIELDS.length) continue;
+        const r = {};
+        FIELDS.forEach((f, i) => { r[f] = v[i]; });
+        base.push(r);
+    }
+    return base;
+}
+
+function checkBaseline(results, base, flags) {
+    for (const r of results) {
+        const b = base.find(x => x.m === r.m && x.t === r.t);
+        if (!b) continue;
+        if (r.table_bytes > b.table_bytes * (1 + opt.memSlack)) {
+            flags.push(`table_bytes ${r.table_bytes} > baseline ${b.table_bytes} at ${config(r)}`);
+        }
+        if (opt.tolerance <= 0) continue;
+        for (const c of COSTS) {
+            const now = c.get(r), was = c.get(b);
+            if (c.ns && was * c.ns >= MIN_NS && now > was * opt.tolerance) {
+                flags.push(`${c.name} ${now.toFixed(1)} > ${opt.tolerance} x baseline ` +
+                           `${was.toFixed(1)} at ${config(r)}`);
+            }
+        }
+    }
+}
+
+function toCsv(results) {
+    const rows = [FIELDS.join(',')];
+    for (const r of results) {
+        rows.push(FIELDS.map(f => (Number.isInteger(r[f]) ? r[f] : r[f].toFixed(1))).join(','));
+    }
+    return rows.join('\n') + '\n';
+}
+
+createLiteBCH().then(Module => {
+    for (const fn of ['encode_raw_ptr', 'decode_raw_ptr', 'table_bytes', 'workspace_bytes']) {
+        if (typeof Module.LiteBCH.prototype[fn] !== 'function') {
+            console.error(`FAIL: the WASM build has no LiteBCH.${fn} (rebuild it)`);
+            process.exit(1);
+        }
+    }
+    const base = opt.baseline ? loadBaseline(opt.baseline) : [];
+    if (!opt.csv) {
+        console.log(`LiteBCH WASM Scalability (best of ${opt.passes} passes, ` +
+                    `decode in ns per codeword, ${Module.vector_backend()})`);
+        console.log('|  m |     N |  t | build us |    tables | wkspace | enc Mbps |  dec 0 err | dec t/2 err | dec t err |');
+        console.log('|----|-------|----|----------|-----------|---------|----------|-----------|-----------|-----------|');
+    }
+
+    const lcg = new SimpleLCG(42);
+    const results = [];
+    for (const m of opt.m) {
+        const N = (1 << m) - 1;
+        for (const t of opt.t) {
+            if (t < 1 || m * t >= N) continue;
+            const r = run(Module, m, t, lcg);
+            results.push(r);
+            if (!opt.csv) {
+                console.log(
+                    `| ${String(m).padStart(2)} | ${String(N).padStart(5)} | ${String(t).padStart(2)} | ` +
+                    `${r.build_us.toFixed(1).padStart(8)} | ${String(r.table_bytes).padStart(9)} | ` +
+                    `${String(r.workspace_bytes).padStart(7)} | ${r.encode_mbps.toFixed(1).padStart(8)} | ` +
+                    `${r.decode_clean_ns.toFixed(1).padStart(9)} | ${r.decode_half_ns.toFixed(1).padStart(9)} | ` +
+                    `${r.decode_t_ns.toFixed(1).padStart(9)} |` + (r.failures ? ` ${r.failures} FAILED` : ''));
+            }
+        }
+    }
+
+    let flags = [];
+    checkScaling(results, flags);
+    checkBaseline(results, base, flags);
+    if (flags.length) {
+        // A slow spell of the machine looks like a regression: measure
+        // again and keep the better figures before reporting.
+        for (const r of results) keepBest(r, run(Module, r.m, r.t, lcg));
+        flags = [];
+        checkScaling(results, flags);
+        checkBaseline(results, base, flags);
+    }
+    const failures = results.reduce((sum, r) => sum + r.failures, 0);
+    if (opt.csv) process.stdout.write(toCsv(results));
+    if (opt.save) fs.writeFileSync(opt.save, toCsv(results));
+    for (const f of flags) console.error(`REGRESSION: ${f}`);
+    if (failures) console.error(`${failures} codewords were not corrected`);
+    process.exit(failures || flags.length ? 1 : 0);
+}).catch(e => {
+    console.error(e);
+    process.exit(1);
+});